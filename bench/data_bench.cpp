@@ -0,0 +1,156 @@
+// Measures the hot paths of the data layer against recorded Yahoo Finance responses (bench/fixtures), so the numbers
+// are reproducible offline: duration and date conversion, CSV (history) and JSON (quote) parsing, and every reply
+// formatter. The getFormatted* functions answer from the quote cache, which is filled with the fixtures first.
+// getFormattedGainsLosses always downloads the history, so its parsing and formatting are measured separately.
+// Usage: ./equity-bench --benchmark_filter=Data
+
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "data.h"
+#include "quotecache.h"
+
+// Symbols of the fixtures and the files with their options (quote) responses
+static const std::vector<std::pair<std::string, std::string>> QUOTE_FIXTURES = {
+    {"AAPL", "options_AAPL.json"},
+    {"MSFT", "options_MSFT.json"},
+    {"NVDA", "options_NVDA.json"},
+    {"TSLA", "options_TSLA.json"},
+    {"^GSPC", "options_GSPC.json"},
+    {"GC=F", "options_GC_F.json"},
+    {"EURUSD=X", "options_EURUSD_X.json"},
+    {"BTC-USD", "options_BTC-USD.json"},
+};
+
+// Returns the contents of a fixture
+static std::string readFixture(const std::string &name)
+{
+    std::ifstream file(std::string(EQUITY_FIXTURES_DIR) + "/" + name);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not open fixture " << name << std::endl;
+        return "";
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// Parses the quote fixtures and stores them in the quote cache (the quotes are closed, so they stay valid for minutes)
+static std::vector<std::string> primeQuoteCache()
+{
+    std::vector<std::string> symbols;
+    for (const auto &[symbol, file] : QUOTE_FIXTURES)
+    {
+        QuoteCache::instance().put(symbol, parseMetrics(symbol, readFixture(file)));
+        symbols.push_back(symbol);
+    }
+    return symbols;
+}
+
+static void BM_DataDurationInSeconds(benchmark::State &state, const char *duration)
+{
+    std::string text = duration;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getDurationInSeconds(text));
+    }
+}
+BENCHMARK_CAPTURE(BM_DataDurationInSeconds, short, "1y");
+BENCHMARK_CAPTURE(BM_DataDurationInSeconds, long, "6 months");
+
+static void BM_DataUnixTimestamp(benchmark::State &state)
+{
+    std::string date = "18/10/2024";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(convertToUnixTimestamp(date));
+    }
+}
+BENCHMARK(BM_DataUnixTimestamp);
+
+static void BM_DataParseOHLC(benchmark::State &state)
+{
+    std::string csv = readFixture("history_AAPL.csv");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseOHLCData(csv));
+    }
+    state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_DataParseOHLC);
+
+static void BM_DataParseMetrics(benchmark::State &state, const char *symbol, const char *file)
+{
+    std::string response = readFixture(file);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseMetrics(symbol, response));
+    }
+    state.SetBytesProcessed(state.iterations() * response.size());
+}
+BENCHMARK_CAPTURE(BM_DataParseMetrics, equity, "AAPL", "options_AAPL.json"); // With an options chain
+BENCHMARK_CAPTURE(BM_DataParseMetrics, index, "^GSPC", "options_GSPC.json");  // Quote only
+
+static void BM_DataFormattedPrice(benchmark::State &state)
+{
+    primeQuoteCache();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getFormattedPrice<Markdown, true>("AAPL"));
+    }
+}
+BENCHMARK(BM_DataFormattedPrice);
+
+static void BM_DataFormattedMetrics(benchmark::State &state)
+{
+    primeQuoteCache();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getFormattedMetrics<Markdown>("AAPL"));
+    }
+}
+BENCHMARK(BM_DataFormattedMetrics);
+
+static void BM_DataFormattedPrices(benchmark::State &state)
+{
+    std::vector<std::string> symbols = primeQuoteCache();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getFormattedPrices<Markdown, true>(symbols));
+    }
+}
+BENCHMARK(BM_DataFormattedPrices);
+
+static void BM_DataFormattedJSON(benchmark::State &state)
+{
+    primeQuoteCache();
+    std::string path = std::string(EQUITY_FIXTURES_DIR) + "/group.json";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getFormattedJSON(path, "fixtures", true, true, true));
+    }
+}
+BENCHMARK(BM_DataFormattedJSON);
+
+// getFormattedGainsLosses without the download: parsing and formatting of the history
+static void BM_DataGainsLosses(benchmark::State &state)
+{
+    std::string csv = readFixture("history_AAPL.csv");
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatGainsLosses<Markdown>(parseOHLCData(csv), "USD"));
+    }
+}
+BENCHMARK(BM_DataGainsLosses);
+
+static void BM_DataFormatGainsLosses(benchmark::State &state)
+{
+    std::vector<std::vector<std::string>> ohlcData = parseOHLCData(readFixture("history_AAPL.csv"));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatGainsLosses<Markdown>(ohlcData, "USD"));
+    }
+}
+BENCHMARK(BM_DataFormatGainsLosses);
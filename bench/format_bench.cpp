@@ -0,0 +1,136 @@
+// Compares the reply formatting with std::to_chars into a reused buffer (formatMetrics/formatPrice)
+// with the previous std::ostringstream formatting.
+// Usage: ./equity-bench --benchmark_filter=Format
+
+#include <benchmark/benchmark.h>
+#include <iomanip>
+#include <sstream>
+#include "data.h"
+
+static Metrics sampleMetrics()
+{
+    Metrics metrics;
+    metrics.symbol = "AAPL";
+    metrics.name = "Apple Inc.";
+    metrics.currency = "USD";
+    metrics.marketState = "CLOSED";
+    metrics.marketCap = 2853123456789;
+    metrics.peRatio = 29.41;
+    metrics.latestPrice = 185.27;
+    metrics.latestChange = -0.73;
+    metrics.openPrice = 186.09;
+    metrics.dayLow = 184.35;
+    metrics.dayHigh = 187.12;
+    metrics.prevClose = 186.63;
+    metrics.fiftyTwoWeekLow = 124.17;
+    metrics.fiftyTwoWeekHigh = 199.62;
+    metrics.avg_50 = 189.47;
+    metrics.avg_200 = 178.85;
+    metrics.avgVol_3mo = 54283511;
+    return metrics;
+}
+
+// The stream formatting as it was before the formatting buffer (Markdown metrics reply)
+static std::string streamMetrics(const Metrics &metrics)
+{
+    std::ostringstream formattedMetrics;
+    formattedMetrics << "### Metrics for " << metrics.name << "\n";
+    formattedMetrics << std::fixed << std::setprecision(2);
+    formattedMetrics << "- Market Cap:                          `" << metrics.marketCap << " " << metrics.currency << "`\n";
+    formattedMetrics << "- P/E Ratio:                              `" << metrics.peRatio << "`\n";
+    formattedMetrics << "- Latest Price:                         `" << metrics.latestPrice << " " << metrics.currency << "`\n";
+    formattedMetrics << "- Open price:                           `" << metrics.openPrice << " " << metrics.currency << "`\n";
+    formattedMetrics << "- Day Low:                                `" << metrics.dayLow << " " << metrics.currency << "`\n";
+    formattedMetrics << "- Day High:                               `" << metrics.dayHigh << " " << metrics.currency << "`\n";
+    formattedMetrics << "- Previous Close:                    `" << metrics.prevClose << " " << metrics.currency << "`\n";
+    formattedMetrics << "- 52 Week Low:                       `" << metrics.fiftyTwoWeekLow << " " << metrics.currency << "`\n";
+    formattedMetrics << "- 52 Week High:                      `" << metrics.fiftyTwoWeekHigh << " " << metrics.currency << "`\n";
+    formattedMetrics << "- 50 Day avg:                           `" << metrics.avg_50 << " " << metrics.currency << "`\n";
+    formattedMetrics << "- 200 Day avg:                         `" << metrics.avg_200 << " " << metrics.currency << "`\n";
+    formattedMetrics << std::fixed << std::setprecision(0);
+    formattedMetrics << "- 3 Month Volume avg:         `" << metrics.avgVol_3mo << "`\n";
+    return formattedMetrics.str();
+}
+
+// The stream formatting as it was before the formatting buffer (Markdown price reply)
+static std::string streamPrice(const Metrics &data)
+{
+    std::ostringstream resultStream;
+    resultStream << "### Latest Price for " << data.name << "\n`" << std::fixed << std::setprecision(2) << data.latestPrice << " " << data.currency;
+    if (data.latestChange >= 0)
+    {
+        resultStream << " (+" << std::fixed << std::setprecision(2) << data.latestChange << "%)`:chart_with_upwards_trend:";
+    }
+    else
+    {
+        resultStream << " (" << std::fixed << std::setprecision(2) << data.latestChange << "%)`:chart_with_downwards_trend:";
+    }
+    if (data.marketState != "REGULAR")
+    {
+        resultStream << " *Market is currently closed*" << std::endl;
+    }
+    return resultStream.str();
+}
+
+static void BM_FormatMetrics_Stream(benchmark::State &state)
+{
+    Metrics metrics = sampleMetrics();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(streamMetrics(metrics));
+    }
+}
+BENCHMARK(BM_FormatMetrics_Stream);
+
+static void BM_FormatMetrics_Buffer(benchmark::State &state)
+{
+    Metrics metrics = sampleMetrics();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatMetrics<Markdown>(metrics));
+    }
+}
+BENCHMARK(BM_FormatMetrics_Buffer);
+
+static void BM_FormatPrice_Stream(benchmark::State &state)
+{
+    Metrics metrics = sampleMetrics();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(streamPrice(metrics));
+    }
+}
+BENCHMARK(BM_FormatPrice_Stream);
+
+static void BM_FormatPrice_Buffer(benchmark::State &state)
+{
+    Metrics metrics = sampleMetrics();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatPrice<Markdown, true>(metrics));
+    }
+}
+BENCHMARK(BM_FormatPrice_Buffer);
+
+// Many threads format at the same time in the bot; the stream path also contends on the global locale
+static void BM_FormatMetrics_StreamThreads(benchmark::State &state)
+{
+    Metrics metrics = sampleMetrics();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(streamMetrics(metrics));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatMetrics_StreamThreads)->Threads(8)->UseRealTime();
+
+static void BM_FormatMetrics_BufferThreads(benchmark::State &state)
+{
+    Metrics metrics = sampleMetrics();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatMetrics<Markdown>(metrics));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatMetrics_BufferThreads)->Threads(8)->UseRealTime();
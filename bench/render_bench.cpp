@@ -0,0 +1,110 @@
+// Compares the native chart renderer with the Matplot++ (gnuplot) renderer.
+// Latency: time per chart with one thread. Throughput: charts per second (items_per_second) with several threads.
+// Image formats: size (bytes) and time per chart of every format and compression level.
+// Usage: ./equity-bench --benchmark_filter=Graph|Chart|ImageFormat
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <random>
+#include "visualize.h"
+
+// Creates a random walk of daily OHLCV data (no network needed)
+static ChartData syntheticChartData(size_t days)
+{
+    ChartData data;
+    data.currency = "USD";
+    std::mt19937 generator(42);
+    std::normal_distribution<double> change(0, 0.01);
+    double price = 100;
+    for (size_t i = 0; i < days; i++)
+    {
+        char date[16];
+        std::snprintf(date, sizeof(date), "%04zu-%02zu-%02zu", 2000 + i / 336, 1 + (i / 28) % 12, 1 + i % 28);
+        double open = price * (1 + change(generator));
+        double close = open * (1 + change(generator));
+        data.dates.push_back(date);
+        data.open.push_back(open);
+        data.close.push_back(close);
+        data.high.push_back(std::max(open, close) * (1 + std::abs(change(generator))));
+        data.low.push_back(std::min(open, close) * (1 - std::abs(change(generator))));
+        data.volume.push_back(2e7 * (1 + std::abs(change(generator)) * 50));
+        price = close;
+    }
+    return data;
+}
+
+// Adds the utilization of the gnuplot pool to the results of a Matplot++ benchmark
+static void addPoolCounters(benchmark::State &state, ChartRenderer renderer)
+{
+    if (renderer != ChartRenderer::Matplot)
+    {
+        return;
+    }
+    GnuplotPoolStats stats = getGnuplotPoolStats();
+    state.counters["pool_running"] = static_cast<double>(stats.running);
+    state.counters["pool_waits"] = static_cast<double>(stats.waits);
+    state.counters["pool_wait_ms"] = stats.leases ? stats.waitSeconds * 1000 / stats.leases : 0;
+    state.counters["pool_recycled"] = static_cast<double>(stats.recycled);
+}
+
+static void BM_PriceGraph(benchmark::State &state, ChartRenderer renderer)
+{
+    ChartData data = syntheticChartData(static_cast<size_t>(state.range(0)));
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string image = renderPriceGraph(data, 3, renderer);
+        bytes = image.size();
+        benchmark::DoNotOptimize(image);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["png_bytes"] = static_cast<double>(bytes);
+    addPoolCounters(state, renderer);
+}
+
+static void BM_CandleChart(benchmark::State &state, ChartRenderer renderer)
+{
+    ChartData data = syntheticChartData(static_cast<size_t>(state.range(0)));
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string image = renderCandleChart(data, true, renderer);
+        bytes = image.size();
+        benchmark::DoNotOptimize(image);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["png_bytes"] = static_cast<double>(bytes);
+    addPoolCounters(state, renderer);
+}
+
+// 250 days is about one year of trading days, 1260 about five years
+BENCHMARK_CAPTURE(BM_PriceGraph, native, ChartRenderer::Native)->Arg(250)->Arg(1260)->Unit(benchmark::kMillisecond)->UseRealTime()->ThreadRange(1, 4);
+BENCHMARK_CAPTURE(BM_PriceGraph, matplot, ChartRenderer::Matplot)->Arg(250)->Arg(1260)->Unit(benchmark::kMillisecond)->UseRealTime()->ThreadRange(1, 4);
+BENCHMARK_CAPTURE(BM_CandleChart, native, ChartRenderer::Native)->Arg(250)->Arg(1260)->Unit(benchmark::kMillisecond)->UseRealTime()->ThreadRange(1, 4);
+BENCHMARK_CAPTURE(BM_CandleChart, matplot, ChartRenderer::Matplot)->Arg(250)->Arg(1260)->Unit(benchmark::kMillisecond)->UseRealTime()->ThreadRange(1, 4);
+
+// Draws one year of data with the native renderer in the given format; range(0) is the compression level.
+// Drawing takes the same time for every format, so differences in time come from the encoding.
+static void BM_ImageFormat(benchmark::State &state, bool candles, ImageFormat format)
+{
+    ChartData data = syntheticChartData(250);
+    ImageOptions options;
+    options.format = format;
+    options.compressionLevel = static_cast<int>(state.range(0));
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string image = candles ? renderCandleChart(data, true, ChartRenderer::Native, options)
+                                    : renderPriceGraph(data, 3, ChartRenderer::Native, options);
+        bytes = image.size();
+        benchmark::DoNotOptimize(image);
+    }
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+BENCHMARK_CAPTURE(BM_ImageFormat, price_png, false, ImageFormat::PNG)->Arg(1)->Arg(6)->Arg(9)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageFormat, price_palette_png, false, ImageFormat::PalettePNG)->Arg(1)->Arg(6)->Arg(9)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageFormat, price_svg, false, ImageFormat::SVG)->Arg(0)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageFormat, candle_png, true, ImageFormat::PNG)->Arg(1)->Arg(6)->Arg(9)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageFormat, candle_palette_png, true, ImageFormat::PalettePNG)->Arg(1)->Arg(6)->Arg(9)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageFormat, candle_svg, true, ImageFormat::SVG)->Arg(0)->Unit(benchmark::kMillisecond);
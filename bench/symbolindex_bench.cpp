@@ -0,0 +1,50 @@
+// Measures the autocomplete lookup of the symbol index; Discord allows about 3 seconds, a lookup should take microseconds.
+// Also measures the fuzzy name search (/search), which should stay below a millisecond.
+// Usage: ./equity-bench --benchmark_filter="SymbolLookup|NameSearch"
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include "symbolindex.h"
+
+// Fills the index with synthetic symbols and names (once)
+static SymbolIndex &syntheticIndex()
+{
+    static bool filled = false;
+    SymbolIndex &index = SymbolIndex::instance();
+    if (!filled)
+    {
+        for (int i = 0; i < 10000; i++)
+        {
+            char symbol[16], name[48];
+            std::snprintf(symbol, sizeof(symbol), "S%04d", i);
+            std::snprintf(name, sizeof(name), "Company %d Holdings Inc.", i);
+            index.add(symbol, name);
+        }
+        filled = true;
+    }
+    return index;
+}
+
+static void BM_SymbolLookup(benchmark::State &state, const char *prefix)
+{
+    SymbolIndex &index = syntheticIndex();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.lookup(prefix));
+    }
+}
+BENCHMARK_CAPTURE(BM_SymbolLookup, symbol, "s12");
+BENCHMARK_CAPTURE(BM_SymbolLookup, name, "holdings");
+BENCHMARK_CAPTURE(BM_SymbolLookup, none, "zzz");
+
+static void BM_NameSearch(benchmark::State &state, const char *query)
+{
+    SymbolIndex &index = syntheticIndex();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.search(query));
+    }
+}
+BENCHMARK_CAPTURE(BM_NameSearch, typo, "compnay 1234");
+BENCHMARK_CAPTURE(BM_NameSearch, common, "holdings"); // Matches every name
+BENCHMARK_CAPTURE(BM_NameSearch, none, "xyz");
@@ -1,7 +1,84 @@
 #include "bot.h"
+#include "sharedcache.h"
 
-int main()
+// Prints how to start the bot (normal mode and shard mode)
+static void printUsage()
 {
+    std::cout << "Usage: ./equity-bot [--cluster <id> --clusters <count> [--shards <total>]] [--metrics-port <port>] [--upstream <url>]\n"
+              << "  Without arguments the bot runs all shards in this process.\n"
+              << "  In shard mode, this process runs the shards for which shard_id % count == id.\n"
+              << "  All processes on the same host share a quote and OHLC cache in shared memory.\n"
+              << "  Metrics are served at http://127.0.0.1:<port>/metrics (default " << METRICS_PORT << " + cluster id, 0 = off).\n"
+              << "  Yahoo Finance is reached at " << DEFAULT_UPSTREAM_URL << " unless another base URL is given (e.g. a replay server).\n";
+}
+
+int main(int argc, char *argv[])
+{
+    // Parse shard mode arguments
+    uint32_t shards = 0;
+    uint32_t clusterId = 0;
+    uint32_t maxClusters = 1;
+    bool shardMode = false;
+    long metricsPort = -1;
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                printUsage();
+                return 1;
+            }
+            if (arg == "--cluster")
+            {
+                clusterId = std::stoul(argv[++i]);
+                shardMode = true;
+            }
+            else if (arg == "--clusters")
+            {
+                maxClusters = std::stoul(argv[++i]);
+                shardMode = true;
+            }
+            else if (arg == "--shards")
+            {
+                shards = std::stoul(argv[++i]);
+            }
+            else if (arg == "--metrics-port")
+            {
+                metricsPort = std::stol(argv[++i]);
+            }
+            else if (arg == "--upstream")
+            {
+                setUpstreamUrl(argv[++i]);
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        printUsage();
+        return 1;
+    }
+    if (maxClusters == 0 || clusterId >= maxClusters)
+    {
+        std::cout << "Error: cluster id must be between 0 and the number of clusters - 1.\n";
+        return 1;
+    }
+    if (metricsPort < 0)
+    {
+        metricsPort = METRICS_PORT + clusterId; // Every process of a host needs its own port
+    }
+    if (metricsPort > 65535)
+    {
+        std::cout << "Error: metrics port must be between 0 and 65535.\n";
+        return 1;
+    }
+
     // Read bot token from .config file
     std::ifstream configFile("../.config");
     std::string BOT_TOKEN;
@@ -16,8 +93,14 @@ int main()
         return 1;
     }
 
+    // In shard mode, share fetched data with the other processes on this host
+    if (shardMode && !SharedCache::attach("/equity-bot-cache"))
+    {
+        std::cout << "Warning: running without shared cache.\n";
+    }
+
     // Create bot and run it
-    Bot bot(BOT_TOKEN);
+    Bot bot(BOT_TOKEN, shards, clusterId, maxClusters, static_cast<uint16_t>(metricsPort));
     bot.run();
 
     return 0;
@@ -1,6 +1,33 @@
 #include "bot.h"
 
-Bot::Bot(const std::string &token) : bot(token, dpp::i_default_intents | dpp::i_message_content)
+// Returns a completion callback that records how long Discord took to accept a reply (mostly the upload of the chart)
+static dpp::command_completion_event_t uploadTimer(const std::string &command)
+{
+    auto sent = std::chrono::steady_clock::now();
+    return [command, sent](const dpp::confirmation_callback_t &callback)
+    {
+        Telemetry::instance().record(command, "upload", std::chrono::steady_clock::now() - sent);
+        if (callback.is_error())
+        {
+            std::cerr << "Reply failed: " << callback.get_error().message << std::endl;
+            Telemetry::instance().increment("equity_discord_errors_total", "command=\"" + command + "\"");
+        }
+    };
+}
+
+Bot::Bot(const std::string &token, uint32_t shards, uint32_t clusterId, uint32_t maxClusters, uint16_t metricsPort)
+    : bot(token, dpp::i_default_intents | dpp::i_message_content, shards, clusterId, maxClusters), clusterId(clusterId),
+      catalog("../data"),
+      commands([this]()
+               { return catalog.current(); }),
+      quotes([this]()
+             { return catalog.current()->allSymbols(); }),
+      dashboards([this]()
+                 { return catalog.current(); },
+                 {"indices", "industries"},
+                 {{false, "1y", 3, false},   // Price graph (open and close) of the last year
+                  {true, "3mo", 0, false}}), // Candlestick chart of the last 3 months
+      metricsPort(metricsPort), metrics(metricsPort)
 {
     bot.on_log(dpp::utility::cout_logger());
 }
@@ -8,233 +35,126 @@ Bot::Bot(const std::string &token) : bot(token, dpp::i_default_intents | dpp::i_
 void Bot::run()
 {
     setupBot();
+    catalog.start(); // Edited catalog files are picked up without a restart
+    quotes.start();  // Catalog commands answer from the quote cache
+    if (metricsPort != 0)
+    {
+        metrics.start();
+    }
     bot.start(dpp::st_wait);
 }
 
 void Bot::setupBot()
 {
+    // Utilization of the gnuplot workers (only used by the Matplot++ renderer)
+    Telemetry::instance().addCollector([](std::string &out)
+                                       {
+                                           GnuplotPoolStats stats = getGnuplotPoolStats();
+                                           out += "# TYPE equity_gnuplot_workers gauge\n";
+                                           out += "equity_gnuplot_workers{state=\"running\"} " + std::to_string(stats.running) + "\n";
+                                           out += "equity_gnuplot_workers{state=\"busy\"} " + std::to_string(stats.busy) + "\n";
+                                           out += "# TYPE equity_gnuplot_leases_total counter\n";
+                                           out += "equity_gnuplot_leases_total " + std::to_string(stats.leases) + "\n";
+                                           out += "# TYPE equity_gnuplot_waits_total counter\n";
+                                           out += "equity_gnuplot_waits_total " + std::to_string(stats.waits) + "\n";
+                                           out += "# TYPE equity_gnuplot_wait_seconds_total counter\n";
+                                           out += "equity_gnuplot_wait_seconds_total " + std::to_string(stats.waitSeconds) + "\n";
+                                           out += "# TYPE equity_gnuplot_failures_total counter\n";
+                                           out += "equity_gnuplot_failures_total " + std::to_string(stats.failures) + "\n";
+                                           out += "# TYPE equity_gnuplot_recycled_total counter\n";
+                                           out += "equity_gnuplot_recycled_total " + std::to_string(stats.recycled) + "\n";
+                                       });
+
     bot.on_slashcommand([this](const dpp::slashcommand_t &event)
                         { commandHandler(event); });
 
+    bot.on_autocomplete([this](const dpp::autocomplete_t &event)
+                        { autocompleteHandler(event); });
+
     bot.on_ready([this](const dpp::ready_t &event)
                  { onReady(event); });
 }
 
 void Bot::commandHandler(const dpp::slashcommand_t &event)
 {
-    if (event.command.get_command_name() == "latestprice")
-    {
-        std::string symbol = std::get<std::string>(event.get_parameter("symbol"));
-        std::string priceStr = getFormattedPrice(symbol, true, true);
-        event.reply(priceStr);
-    }
-    else if (event.command.get_command_name() == "pricegraph")
-    {
-        std::string symbol = std::get<std::string>(event.get_parameter("symbol"));
-        std::string period = std::get<std::string>(event.get_parameter("period"));
-        std::string mode = std::get<std::string>(event.get_parameter("mode"));
-
-        // Get name of symbol (this will be added to the message instead of just adding the symbol)
-        Metrics metrics = fetchMetrics(symbol);
-        std::string name = metrics.name;
-
-        // Check if duration is valid and not too short, and add note if it is too short
-        std::time_t duration = getDurationInSeconds(period);
-        std::string note = "";
-        if (duration == 0)
-        {
-            dpp::message errorMsg{"Invalid period format. Examples of supported formats: 7mo, 1w, 3y, 6d, "
-                                  "where mo = month, w = week, y = year, and d = day."};
-            event.reply(errorMsg);
-        }
-        if (duration < 259200)
-        {
-            period = "3 days";
-            note = "Note: period has been set to 3 days, because periods shorter than 3 days may result in an empty graph";
-        }
-        // Create graph
-        priceGraph(symbol, period, std::stoi(mode));
-
-        // Additional delay to make sure the file is fully written to disk
-        // Without this delay the bot sends an empty image file
-        std::this_thread::sleep_for(std::chrono::milliseconds{1000});
+    std::string command = event.command.get_command_name();
+    CommandScope scope(command); // Stages below are recorded for this command
 
-        // If the file exists, add it to the message
-        const std::string imagePath = "../images/price_graph.png";
-        if (std::filesystem::exists(imagePath))
-        {
-            // Add note if the duration has been adjusted
-            dpp::message msg{"### Price Graph for " + name + "\n" + note};
-            msg.add_file("price_graph.png", dpp::utility::read_file(imagePath));
-            event.reply(msg);
-                
-            // Delete the file after sending the message
-            std::filesystem::remove(imagePath);
-        }
-        else
-        {
-            // If the file doesn't exist, reply with an error message
-            dpp::message errorMsg{"Oops! Something went wrong while creating the graph."};
-            event.reply(errorMsg);
-        }  
-    }
-    else if (event.command.get_command_name() == "candlestick")
+    // All options of the commands are strings
+    CommandOptions options;
+    for (const dpp::command_data_option &option : event.command.get_command_interaction().options)
     {
-        std::string symbol = std::get<std::string>(event.get_parameter("symbol"));
-        std::string period = std::get<std::string>(event.get_parameter("period"));
-        std::string showV = std::get<std::string>(event.get_parameter("volume"));
-
-        // Get name of symbol (this will be added to the message instead of just adding the symbol)
-        Metrics metrics = fetchMetrics(symbol);
-        std::string name = metrics.name;
-
-        // Check if duration is valid and in case it is too long, add note
-        std::time_t duration = getDurationInSeconds(period);
-        std::string note = "";
-        if (duration == 0)
+        if (std::holds_alternative<std::string>(option.value))
         {
-            dpp::message errorMsg{"Invalid period format. Examples of supported formats: 7mo, 1w, 3y, 6d, "
-                                  "where mo = month, w = week, y = year, and d = day."};
-            event.reply(errorMsg);
+            options[option.name] = std::get<std::string>(option.value);
         }
-        if (duration > 31536000)
-        {
-            note = "To ensure readability of the chart, a period of longer than 1 year is not recommended.";
-        }
-        
-        // Create candlestick chart
-        (showV == "n") ? createCandleChart(symbol, period, false) : createCandleChart(symbol, period, true);
-        
-        // Additional delay to make sure the file is fully written to disk
-        // Without this delay the bot sends an empty image file
-        std::this_thread::sleep_for(std::chrono::milliseconds{1000});
-
-        // If the file exists, add it to the message
-        std::string imagePath = "../images/candle_chart.png";
-        if (std::filesystem::exists(imagePath))
-        {
-            dpp::message msg{"### Candlestick chart for " + name + "\n" + note};
-            msg.add_file("candle_chart.png", dpp::utility::read_file(imagePath));
-            event.reply(msg);
-            
-            // Delete the file after sending the message
-            std::filesystem::remove(imagePath);
-        }
-        else
-        {
-            // If the file doesn't exist, reply with an error message
-            dpp::message errorMsg{"Oops! Something went wrong while creating the candlestick chart."};
-            event.reply(errorMsg);
-        }
-    }
-    else if (event.command.get_command_name() == "metrics")
-    {
-        std::string symbol = std::get<std::string>(event.get_parameter("symbol"));
-        std::string metrics = getFormattedMetrics(symbol, true);
-        event.reply(metrics);
-    }
-    else if (event.command.get_command_name() == "majorindices")
-    {
-        std::string region = std::get<std::string>(event.get_parameter("region"));
-        std::string description = std::get<std::string>(event.get_parameter("description"));
-        bool showDesc = (description == "n") ? false : true;
-        event.reply(getFormattedJSON("../data/indices.json", region, true, showDesc, true));
-    }
-    else if (event.command.get_command_name() == "commodities")
-    {
-        event.reply(getFormattedJSON("../data/commodities.json", "commodities", true, false, true));
     }
-    else if (event.command.get_command_name() == "currencies")
+
+    if (commands.isProgressive(command, options))
     {
-        event.reply(getFormattedJSON("../data/currencies.json", "currencies", true, false, true));
+        ProgressiveReply reply(event); // Shows the first symbols while the others are still being fetched
+        reply.finish(commands.execute(command, options, [&reply](const std::string &partial)
+                                      { reply.update(partial); }).content);
+        return;
     }
-    else if (event.command.get_command_name() == "industries")
+
+    CommandReply reply = commands.execute(command, options);
+    if (!reply.fileName.empty())
     {
-        std::string industry = std::get<std::string>(event.get_parameter("industry"));
-        event.reply(getFormattedJSON("../data/industries.json", industry, true, false, true));
+        dpp::message msg{reply.content};
+        msg.add_file(reply.fileName, reply.fileContents, reply.fileMimeType);
+        event.reply(msg, uploadTimer(command));
     }
-    else if (event.command.get_command_name() == "crypto")
+    else if (!reply.content.empty())
     {
-        event.reply(getFormattedJSON("../data/currencies.json", "cryptocurrencies", true, false, true));
+        event.reply(reply.content);
     }
-    else if (event.command.get_command_name() == "movements")
-    {
-        std::string symbol = std::get<std::string>(event.get_parameter("symbol"));
-        std::string period = std::get<std::string>(event.get_parameter("period"));
-
-        // Get name of symbol (this will be added to the message instead of just adding the symbol)
-        Metrics metrics = fetchMetrics(symbol);
-        std::string name = metrics.name;
-
-        // Check if duration is valid, and not too short
-        std::time_t duration = getDurationInSeconds(period);
-        std::string note = "";
-        if (duration == 0)
-        {
-            dpp::message errorMsg{"Invalid period format. Examples of supported formats: 7mo, 1w, 3y, 6d, "
-                                "where mo = month, w = week, y = year, and d = day."};
-            event.reply(errorMsg);
-            return;
-        }
-        if (duration < 2592000)
-        {
-            duration = 2592000;
-            note = "Note: the period provided was too short and has therefore been set to one month.";
-        }
-
-        // Extract numeric and non-numeric parts of the period
-        std::string numericPart = "";
-        std::string nonNumericPart = "";
-        for (char c : period)
-        {
-            if (isdigit(c))
-            {
-                numericPart += c;
-            }
-            else
-            {
-                nonNumericPart += c;
-            }
-        }
-
-        int timeValue = std::stoi(numericPart);
-        char periodType = nonNumericPart[0];
+}
 
-        // Construct the period string for the message
-        std::string periodDescription;
-        if (periodType == 'y')
-        {
-            periodDescription = (timeValue == 1) ? "in the last year" : "in the last " + std::to_string(timeValue) + " years";
-        }
-        else if (periodType == 'm')
-        {
-            periodDescription = (timeValue == 1) ? "in the last month" : "in the last " + std::to_string(timeValue) + " months";
-        }
-        else if (periodType == 'w')
-        {
-            periodDescription = "in the last " + std::to_string(timeValue) + " weeks";
-        }
-        else if (periodType == 'd')
+void Bot::autocompleteHandler(const dpp::autocomplete_t &event)
+{
+    commands.syncSymbolIndex();
+    for (const dpp::command_option &option : event.options)
+    {
+        if (!option.focused || option.name != "symbol")
         {
-            periodDescription = "in the last " + std::to_string(timeValue) + " days";
+            continue;
         }
 
-        // Get top 5 biggest gains and losses (in % change)
-        std::string result = getFormattedGainsLosses(symbol, period, true);
-        if (result != "")
+        std::string typed = std::holds_alternative<std::string>(option.value) ? std::get<std::string>(option.value) : "";
+        dpp::interaction_response response(dpp::ir_autocomplete_reply);
+        for (const SymbolMatch &match : SymbolIndex::instance().lookup(typed))
         {
-            dpp::message msg{"### Biggest gains and losses for " + name + " " + periodDescription + "\n" + note + "\n" + result};
-            event.reply(msg);
+            // Choice names are limited to 100 characters by Discord
+            std::string label = match.name.empty() ? match.symbol : match.symbol + " - " + match.name;
+            response.add_autocomplete_choice(dpp::command_option_choice(label.substr(0, 100), match.symbol));
         }
+        bot.interaction_response_create(event.command.id, event.command.token, response);
+        break;
     }
 }
 
 void Bot::onReady(const dpp::ready_t &event)
 {
-    if (dpp::run_once<struct register_bot_commands>())
+    // Commands are global, so in shard mode only the first process registers them
+    if (clusterId == 0 && dpp::run_once<struct register_bot_commands>())
     {
         registerCommands();
     }
+
+    // Keep the cached replies fresh (this also builds them for the first time)
+    if (dpp::run_once<struct start_response_refresh>())
+    {
+        commands.responses().refreshExpiring();
+        bot.start_timer([this](dpp::timer)
+                        { commands.responses().refreshExpiring(); }, 5);
+    }
+
+    // Pre-render the charts of the major indices and industries in the background
+    if (dpp::run_once<struct start_dashboards>())
+    {
+        dashboards.start(bot);
+    }
 }
 
 void Bot::registerCommands()
@@ -242,12 +162,12 @@ void Bot::registerCommands()
     // Create slash command for latestprice
     dpp::slashcommand latestprice("latestprice", "Get the latest price of a stock, future, index or crypto", bot.me.id);
     latestprice.add_option(
-        dpp::command_option(dpp::co_string, "symbol", "Symbol", true));
+        dpp::command_option(dpp::co_string, "symbol", "Symbol", true).set_auto_complete(true));
 
     // Create slash command for pricegraoh
     dpp::slashcommand pricegraph("pricegraph", "Get a graph of the closing and/or open price of a stock, future, index or crypto", bot.me.id);
     pricegraph.add_option(
-        dpp::command_option(dpp::co_string, "symbol", "Symbol", true));
+        dpp::command_option(dpp::co_string, "symbol", "Symbol", true).set_auto_complete(true));
     pricegraph.add_option(
         dpp::command_option(dpp::co_string, "period", "Period (e.g. 10d, 2w, 3mo, 1y)", true));
     pricegraph.add_option(
@@ -259,7 +179,7 @@ void Bot::registerCommands()
     // Create slash command for candlestick
     dpp::slashcommand candlestick("candlestick", "Get a candlestick chart for a stock, future, index or crypto (optionally with volumes)", bot.me.id);
     candlestick.add_option(
-        dpp::command_option(dpp::co_string, "symbol", "Symbol", true));
+        dpp::command_option(dpp::co_string, "symbol", "Symbol", true).set_auto_complete(true));
     candlestick.add_option(
         dpp::command_option(dpp::co_string, "period", "Period (e.g. 10d, 2w, 3mo)", true));
     candlestick.add_option(
@@ -282,7 +202,7 @@ void Bot::registerCommands()
     // Create slash command for metrics
     dpp::slashcommand metrics("metrics", "Get metrics of a stock, future or index", bot.me.id);
     metrics.add_option(
-        dpp::command_option(dpp::co_string, "symbol", "Symbol", true));
+        dpp::command_option(dpp::co_string, "symbol", "Symbol", true).set_auto_complete(true));
 
     // Create slash command for commodities
     dpp::slashcommand commodities("commodities", "Get the latest price info for different commodities", bot.me.id);
@@ -309,10 +229,15 @@ void Bot::registerCommands()
     // Create slash command for biggest gains and losses
     dpp::slashcommand movements("movements", "Get the top 5 biggest gains and losses of a stock, future, index or crypto", bot.me.id);
     movements.add_option(
-        dpp::command_option(dpp::co_string, "symbol", "Symbol", true));
+        dpp::command_option(dpp::co_string, "symbol", "Symbol", true).set_auto_complete(true));
     movements.add_option(
         dpp::command_option(dpp::co_string, "period", "Period (e.g. 10d, 2w, 3mo, 1y)", true));
     
+    // Create slash command for search
+    dpp::slashcommand search("search", "Find the symbol of a company, index, commodity or currency by its name", bot.me.id);
+    search.add_option(
+        dpp::command_option(dpp::co_string, "name", "Name (e.g. Volkswagen)", true));
+
     // Add commands to vector and register them
     std::vector<dpp::slashcommand> commands;
     commands.push_back(latestprice);
@@ -325,5 +250,6 @@ void Bot::registerCommands()
     commands.push_back(industries);
     commands.push_back(crypto);
     commands.push_back(movements);
+    commands.push_back(search);
     bot.global_bulk_command_create(commands);
 }
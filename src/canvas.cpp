@@ -0,0 +1,538 @@
+#include "canvas.h"
+#include "font.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+#include <zlib.h>
+
+static const double PI = 3.14159265358979323846;
+
+// Returns the SVG attributes for a fill or stroke color ("fill" or "stroke"), including its opacity
+static std::string svgPaint(const char *attribute, Color color)
+{
+    char buffer[96];
+    if (color.a == 255)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%s=\"#%02x%02x%02x\"", attribute, color.r, color.g, color.b);
+    }
+    else
+    {
+        std::snprintf(buffer, sizeof(buffer), "%s=\"#%02x%02x%02x\" %s-opacity=\"%.3g\"", attribute, color.r, color.g, color.b, attribute, color.a / 255.0);
+    }
+    return buffer;
+}
+
+// Formats a coordinate for SVG (two decimals are more than enough)
+static std::string svgNumber(double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+    return buffer;
+}
+
+Canvas::Canvas(int width, int height, Color background) : w(width), h(height), rgba(static_cast<size_t>(width) * height * 4), background(background)
+{
+    for (size_t i = 0; i < rgba.size(); i += 4)
+    {
+        rgba[i] = background.r;
+        rgba[i + 1] = background.g;
+        rgba[i + 2] = background.b;
+        rgba[i + 3] = background.a;
+    }
+}
+
+int Canvas::width() const
+{
+    return w;
+}
+
+int Canvas::height() const
+{
+    return h;
+}
+
+const std::vector<std::uint8_t> &Canvas::pixels() const
+{
+    return rgba;
+}
+
+void Canvas::blend(int x, int y, Color color, float coverage)
+{
+    if (x < 0 || y < 0 || x >= w || y >= h || coverage <= 0)
+    {
+        return;
+    }
+    float alpha = std::min(coverage, 1.f) * (color.a / 255.f);
+    std::uint8_t *pixel = &rgba[(static_cast<size_t>(y) * w + x) * 4];
+    pixel[0] = static_cast<std::uint8_t>(pixel[0] + (color.r - pixel[0]) * alpha + 0.5f);
+    pixel[1] = static_cast<std::uint8_t>(pixel[1] + (color.g - pixel[1]) * alpha + 0.5f);
+    pixel[2] = static_cast<std::uint8_t>(pixel[2] + (color.b - pixel[2]) * alpha + 0.5f);
+    pixel[3] = static_cast<std::uint8_t>(pixel[3] + (255 - pixel[3]) * alpha + 0.5f);
+}
+
+void Canvas::fillRect(double x0, double y0, double x1, double y1, Color color)
+{
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+    }
+    if (y0 > y1)
+    {
+        std::swap(y0, y1);
+    }
+
+    if (recording)
+    {
+        svg += "<rect x=\"" + svgNumber(x0) + "\" y=\"" + svgNumber(y0) + "\" width=\"" + svgNumber(x1 - x0) +
+               "\" height=\"" + svgNumber(y1 - y0) + "\" " + svgPaint("fill", color) + "/>\n";
+    }
+
+    int left = std::max(0, static_cast<int>(std::floor(x0)));
+    int right = std::min(w - 1, static_cast<int>(std::ceil(x1)) - 1);
+    int top = std::max(0, static_cast<int>(std::floor(y0)));
+    int bottom = std::min(h - 1, static_cast<int>(std::ceil(y1)) - 1);
+
+    // Coverage of a pixel is the part of its area inside the rectangle
+    for (int y = top; y <= bottom; y++)
+    {
+        double coverY = std::min(y1, y + 1.0) - std::max(y0, static_cast<double>(y));
+        for (int x = left; x <= right; x++)
+        {
+            double coverX = std::min(x1, x + 1.0) - std::max(x0, static_cast<double>(x));
+            blend(x, y, color, static_cast<float>(coverX * coverY));
+        }
+    }
+}
+
+void Canvas::drawLine(double x0, double y0, double x1, double y1, double lineWidth, Color color)
+{
+    drawPolyline({x0, x1}, {y0, y1}, lineWidth, color);
+}
+
+void Canvas::drawPolyline(const std::vector<double> &xs, const std::vector<double> &ys, double lineWidth, Color color)
+{
+    size_t count = std::min(xs.size(), ys.size());
+    if (count == 0)
+    {
+        return;
+    }
+    double halfWidth = lineWidth / 2;
+
+    if (recording)
+    {
+        svg += "<polyline points=\"";
+        for (size_t i = 0; i < count; i++)
+        {
+            svg += svgNumber(xs[i]) + "," + svgNumber(ys[i]) + (i + 1 < count ? " " : "");
+        }
+        svg += "\" fill=\"none\" " + svgPaint("stroke", color) + " stroke-width=\"" + svgNumber(lineWidth) +
+               "\" stroke-linecap=\"round\" stroke-linejoin=\"round\"/>\n";
+    }
+
+    // Bounding box of the whole line (clipped to the canvas)
+    double minX = *std::min_element(xs.begin(), xs.begin() + count);
+    double maxX = *std::max_element(xs.begin(), xs.begin() + count);
+    double minY = *std::min_element(ys.begin(), ys.begin() + count);
+    double maxY = *std::max_element(ys.begin(), ys.begin() + count);
+    int left = std::max(0, static_cast<int>(std::floor(minX - halfWidth - 1)));
+    int right = std::min(w - 1, static_cast<int>(std::ceil(maxX + halfWidth + 1)));
+    int top = std::max(0, static_cast<int>(std::floor(minY - halfWidth - 1)));
+    int bottom = std::min(h - 1, static_cast<int>(std::ceil(maxY + halfWidth + 1)));
+    if (left > right || top > bottom)
+    {
+        return;
+    }
+
+    // Coverage of every segment is collected first (maximum per pixel), then blended once
+    int maskWidth = right - left + 1;
+    std::vector<float> mask(static_cast<size_t>(maskWidth) * (bottom - top + 1), 0.f);
+    for (size_t i = 0; i < count; i++)
+    {
+        double ax = xs[i], ay = ys[i];
+        double bx = (i + 1 < count) ? xs[i + 1] : ax;
+        double by = (i + 1 < count) ? ys[i + 1] : ay;
+        if (count > 1 && i + 1 == count)
+        {
+            break;
+        }
+        double dx = bx - ax, dy = by - ay;
+        double lengthSquared = dx * dx + dy * dy;
+
+        int segLeft = std::max(left, static_cast<int>(std::floor(std::min(ax, bx) - halfWidth - 1)));
+        int segRight = std::min(right, static_cast<int>(std::ceil(std::max(ax, bx) + halfWidth + 1)));
+        int segTop = std::max(top, static_cast<int>(std::floor(std::min(ay, by) - halfWidth - 1)));
+        int segBottom = std::min(bottom, static_cast<int>(std::ceil(std::max(ay, by) + halfWidth + 1)));
+        for (int y = segTop; y <= segBottom; y++)
+        {
+            double py = y + 0.5;
+            for (int x = segLeft; x <= segRight; x++)
+            {
+                // Distance from the pixel center to the segment
+                double px = x + 0.5;
+                double t = (lengthSquared > 0) ? std::clamp(((px - ax) * dx + (py - ay) * dy) / lengthSquared, 0.0, 1.0) : 0.0;
+                double ex = px - (ax + t * dx), ey = py - (ay + t * dy);
+                double distance = std::sqrt(ex * ex + ey * ey);
+                float coverage = static_cast<float>(std::clamp(halfWidth + 0.5 - distance, 0.0, 1.0));
+                float &cell = mask[static_cast<size_t>(y - top) * maskWidth + (x - left)];
+                cell = std::max(cell, coverage);
+            }
+        }
+    }
+
+    for (int y = top; y <= bottom; y++)
+    {
+        for (int x = left; x <= right; x++)
+        {
+            blend(x, y, color, mask[static_cast<size_t>(y - top) * maskWidth + (x - left)]);
+        }
+    }
+}
+
+double Canvas::textWidth(const std::string &text)
+{
+    double width = 0;
+    for (char c : text)
+    {
+        width += getGlyph(c).advance;
+    }
+    return width;
+}
+
+void Canvas::drawText(const std::string &text, double x, double y, Color color, double hAlign, double angle)
+{
+    int maskWidth = static_cast<int>(textWidth(text)) + 2;
+    int maskHeight = FONT_LINE_HEIGHT;
+    if (text.empty())
+    {
+        return;
+    }
+
+    if (recording)
+    {
+        // The anchor is at the middle of the capitals, so the baseline is half the cap height below it
+        std::string escaped;
+        for (char c : text)
+        {
+            escaped += (c == '&') ? "&amp;" : (c == '<') ? "&lt;" : (c == '>') ? "&gt;" : std::string(1, c);
+        }
+        const char *anchor = (hAlign < 0.25) ? "start" : (hAlign > 0.75) ? "end" : "middle";
+        svg += "<text x=\"" + svgNumber(x) + "\" y=\"" + svgNumber(y + FONT_CAP_HEIGHT / 2.0) + "\" text-anchor=\"" + anchor + "\"";
+        if (angle != 0)
+        {
+            svg += " transform=\"rotate(" + svgNumber(-angle) + " " + svgNumber(x) + " " + svgNumber(y) + ")\"";
+        }
+        svg += " " + svgPaint("fill", color) + ">" + escaped + "</text>\n";
+    }
+
+    // Render the text into a coverage mask (baseline at FONT_ASCENT)
+    std::vector<std::uint8_t> mask(static_cast<size_t>(maskWidth) * maskHeight, 0);
+    int pen = 0;
+    for (char c : text)
+    {
+        const Glyph &glyph = getGlyph(c);
+        const unsigned char *alpha = getGlyphAlpha(glyph);
+        for (int row = 0; row < glyph.height; row++)
+        {
+            int my = FONT_ASCENT - glyph.top + row;
+            for (int col = 0; col < glyph.width; col++)
+            {
+                int mx = pen + glyph.left + col;
+                if (mx >= 0 && mx < maskWidth && my >= 0 && my < maskHeight)
+                {
+                    std::uint8_t &cell = mask[static_cast<size_t>(my) * maskWidth + mx];
+                    cell = std::max(cell, alpha[row * glyph.width + col]);
+                }
+            }
+        }
+        pen += glyph.advance;
+    }
+
+    // Anchor point inside the mask
+    double anchorX = hAlign * (maskWidth - 2);
+    double anchorY = FONT_ASCENT - FONT_CAP_HEIGHT / 2.0;
+
+    if (angle == 0)
+    {
+        // Unrotated text is copied pixel by pixel, which keeps it sharp
+        int offsetX = static_cast<int>(std::lround(x - anchorX));
+        int offsetY = static_cast<int>(std::lround(y - anchorY));
+        for (int my = 0; my < maskHeight; my++)
+        {
+            for (int mx = 0; mx < maskWidth; mx++)
+            {
+                std::uint8_t coverage = mask[static_cast<size_t>(my) * maskWidth + mx];
+                if (coverage)
+                {
+                    blend(offsetX + mx, offsetY + my, color, coverage / 255.f);
+                }
+            }
+        }
+        return;
+    }
+
+    // Rotated text: map every canvas pixel back into the mask and sample it bilinearly
+    double radians = angle * PI / 180.0;
+    double cosA = std::cos(radians), sinA = std::sin(radians);
+    double corners[4][2] = {{-anchorX, -anchorY}, {maskWidth - anchorX, -anchorY}, {-anchorX, maskHeight - anchorY}, {maskWidth - anchorX, maskHeight - anchorY}};
+    double minX = 1e9, maxX = -1e9, minY = 1e9, maxY = -1e9;
+    for (const auto &corner : corners)
+    {
+        double cx = x + corner[0] * cosA + corner[1] * sinA;
+        double cy = y - corner[0] * sinA + corner[1] * cosA;
+        minX = std::min(minX, cx);
+        maxX = std::max(maxX, cx);
+        minY = std::min(minY, cy);
+        maxY = std::max(maxY, cy);
+    }
+
+    auto sample = [&](int mx, int my) -> float
+    {
+        if (mx < 0 || my < 0 || mx >= maskWidth || my >= maskHeight)
+        {
+            return 0.f;
+        }
+        return mask[static_cast<size_t>(my) * maskWidth + mx] / 255.f;
+    };
+
+    for (int py = std::max(0, static_cast<int>(minY) - 1); py <= std::min(h - 1, static_cast<int>(maxY) + 1); py++)
+    {
+        for (int px = std::max(0, static_cast<int>(minX) - 1); px <= std::min(w - 1, static_cast<int>(maxX) + 1); px++)
+        {
+            double dx = px + 0.5 - x, dy = py + 0.5 - y;
+            double u = dx * cosA - dy * sinA + anchorX - 0.5;
+            double v = dx * sinA + dy * cosA + anchorY - 0.5;
+            int u0 = static_cast<int>(std::floor(u)), v0 = static_cast<int>(std::floor(v));
+            float fu = static_cast<float>(u - u0), fv = static_cast<float>(v - v0);
+            float coverage = sample(u0, v0) * (1 - fu) * (1 - fv) + sample(u0 + 1, v0) * fu * (1 - fv) +
+                             sample(u0, v0 + 1) * (1 - fu) * fv + sample(u0 + 1, v0 + 1) * fu * fv;
+            blend(px, py, color, coverage);
+        }
+    }
+}
+
+// Appends a 32-bit big-endian number
+static void appendUint32(std::string &out, std::uint32_t value)
+{
+    out += static_cast<char>((value >> 24) & 0xFF);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>(value & 0xFF);
+}
+
+// Appends a PNG chunk (length, type, data, CRC of type and data)
+static void appendChunk(std::string &png, const char *type, const std::string &data)
+{
+    appendUint32(png, static_cast<std::uint32_t>(data.size()));
+    std::string typeAndData = std::string(type, 4) + data;
+    png += typeAndData;
+    appendUint32(png, static_cast<std::uint32_t>(crc32(0, reinterpret_cast<const Bytef *>(typeAndData.data()), static_cast<uInt>(typeAndData.size()))));
+}
+
+// Compresses filtered rows and wraps them in a PNG file (with a PLTE chunk for palette images)
+static std::string assemblePNG(int width, int height, std::uint8_t bitDepth, std::uint8_t colorType, const std::string &palette,
+                               const std::vector<std::uint8_t> &raw, int compressionLevel)
+{
+    uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+    std::string compressed(compressedSize, '\0');
+    if (compress2(reinterpret_cast<Bytef *>(&compressed[0]), &compressedSize, raw.data(), static_cast<uLong>(raw.size()), compressionLevel) != Z_OK)
+    {
+        return "";
+    }
+    compressed.resize(compressedSize);
+
+    // Header: width, height, bit depth, color type, default compression/filter, no interlace
+    std::string header;
+    appendUint32(header, static_cast<std::uint32_t>(width));
+    appendUint32(header, static_cast<std::uint32_t>(height));
+    header += static_cast<char>(bitDepth);
+    header += static_cast<char>(colorType);
+    header += std::string("\x00\x00\x00", 3);
+
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    appendChunk(png, "IHDR", header);
+    if (!palette.empty())
+    {
+        appendChunk(png, "PLTE", palette);
+    }
+    appendChunk(png, "IDAT", compressed);
+    appendChunk(png, "IEND", "");
+    return png;
+}
+
+// Paeth predictor as defined by the PNG specification
+static int paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+    {
+        return a;
+    }
+    return (pb <= pc) ? b : c;
+}
+
+std::string Canvas::encodePNG(int compressionLevel) const
+{
+    const int bpp = 3; // Bytes per pixel (RGB)
+    const size_t stride = static_cast<size_t>(w) * bpp;
+
+    // Convert to RGB and filter each row with the filter that gives the smallest sum of absolute values
+    std::vector<std::uint8_t> raw;
+    raw.reserve((stride + 1) * h);
+    std::vector<std::uint8_t> previous(stride, 0), current(stride), candidate(stride), best(stride);
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            const std::uint8_t *pixel = &rgba[(static_cast<size_t>(y) * w + x) * 4];
+            current[x * bpp] = pixel[0];
+            current[x * bpp + 1] = pixel[1];
+            current[x * bpp + 2] = pixel[2];
+        }
+
+        long bestSum = -1;
+        std::uint8_t bestFilter = 0;
+        for (std::uint8_t filter : {0, 1, 2, 4}) // None, Sub, Up, Paeth
+        {
+            long sum = 0;
+            for (size_t i = 0; i < stride; i++)
+            {
+                int left = (i >= bpp) ? current[i - bpp] : 0;
+                int up = previous[i];
+                int upLeft = (i >= bpp) ? previous[i - bpp] : 0;
+                int predicted = (filter == 0) ? 0 : (filter == 1) ? left : (filter == 2) ? up : paeth(left, up, upLeft);
+                candidate[i] = static_cast<std::uint8_t>(current[i] - predicted);
+                sum += std::abs(static_cast<std::int8_t>(candidate[i]));
+            }
+            if (bestSum < 0 || sum < bestSum)
+            {
+                bestSum = sum;
+                bestFilter = filter;
+                best.swap(candidate);
+            }
+        }
+        raw.push_back(bestFilter);
+        raw.insert(raw.end(), best.begin(), best.end());
+        previous.swap(current);
+    }
+
+    return assemblePNG(w, h, 8, 2, "", raw, compressionLevel);
+}
+
+std::string Canvas::encodePalettePNG(int compressionLevel, int maxColors) const
+{
+    maxColors = std::clamp(maxColors, 2, 256);
+    const size_t pixelCount = static_cast<size_t>(w) * h;
+    if (pixelCount == 0)
+    {
+        return "";
+    }
+    auto colorAt = [this](size_t i) -> std::uint32_t
+    {
+        return (static_cast<std::uint32_t>(rgba[i * 4]) << 16) | (static_cast<std::uint32_t>(rgba[i * 4 + 1]) << 8) | rgba[i * 4 + 2];
+    };
+
+    // Count the colors (charts consist of long runs of the same color, so runs are counted at once)
+    std::unordered_map<std::uint32_t, size_t> counts;
+    for (size_t i = 0; i < pixelCount;)
+    {
+        std::uint32_t color = colorAt(i);
+        size_t run = 1;
+        while (i + run < pixelCount && colorAt(i + run) == color)
+        {
+            run++;
+        }
+        counts[color] += run;
+        i += run;
+    }
+
+    // The palette consists of the most frequent colors
+    std::vector<std::pair<size_t, std::uint32_t>> byFrequency;
+    byFrequency.reserve(counts.size());
+    for (const auto &[color, count] : counts)
+    {
+        byFrequency.push_back({count, color});
+    }
+    size_t paletteSize = std::min(byFrequency.size(), static_cast<size_t>(maxColors));
+    std::partial_sort(byFrequency.begin(), byFrequency.begin() + paletteSize, byFrequency.end(), std::greater<>());
+    std::string palette;
+    std::unordered_map<std::uint32_t, std::uint8_t> indices;
+    for (size_t i = 0; i < paletteSize; i++)
+    {
+        std::uint32_t color = byFrequency[i].second;
+        palette += static_cast<char>(color >> 16);
+        palette += static_cast<char>((color >> 8) & 0xFF);
+        palette += static_cast<char>(color & 0xFF);
+        indices[color] = static_cast<std::uint8_t>(i);
+    }
+
+    // Remaining colors are mapped to the closest palette color
+    for (size_t i = paletteSize; i < byFrequency.size(); i++)
+    {
+        std::uint32_t color = byFrequency[i].second;
+        long bestDistance = -1;
+        std::uint8_t bestIndex = 0;
+        for (size_t j = 0; j < paletteSize; j++)
+        {
+            std::uint32_t candidate = byFrequency[j].second;
+            long dr = static_cast<long>(color >> 16) - static_cast<long>(candidate >> 16);
+            long dg = static_cast<long>((color >> 8) & 0xFF) - static_cast<long>((candidate >> 8) & 0xFF);
+            long db = static_cast<long>(color & 0xFF) - static_cast<long>(candidate & 0xFF);
+            long distance = dr * dr + dg * dg + db * db;
+            if (bestDistance < 0 || distance < bestDistance)
+            {
+                bestDistance = distance;
+                bestIndex = static_cast<std::uint8_t>(j);
+            }
+        }
+        indices[color] = bestIndex;
+    }
+
+    // Smallest bit depth that can address the palette
+    int bitDepth = (paletteSize <= 2) ? 1 : (paletteSize <= 4) ? 2 : (paletteSize <= 16) ? 4 : 8;
+    int pixelsPerByte = 8 / bitDepth;
+    size_t stride = (static_cast<size_t>(w) + pixelsPerByte - 1) / pixelsPerByte;
+
+    // Indexed rows are not filtered (filter type 0), as recommended for palette images
+    std::vector<std::uint8_t> raw((stride + 1) * h, 0);
+    std::uint32_t lastColor = colorAt(0);
+    std::uint8_t lastIndex = indices[lastColor];
+    for (int y = 0; y < h; y++)
+    {
+        std::uint8_t *row = &raw[(stride + 1) * y + 1];
+        for (int x = 0; x < w; x++)
+        {
+            std::uint32_t color = colorAt(static_cast<size_t>(y) * w + x);
+            if (color != lastColor)
+            {
+                lastColor = color;
+                lastIndex = indices[color];
+            }
+            int shift = 8 - bitDepth * (x % pixelsPerByte + 1);
+            row[x / pixelsPerByte] |= static_cast<std::uint8_t>(lastIndex << shift);
+        }
+    }
+
+    return assemblePNG(w, h, static_cast<std::uint8_t>(bitDepth), 3, palette, raw, compressionLevel);
+}
+
+void Canvas::recordSVG()
+{
+    recording = true;
+    svg = "<rect width=\"100%\" height=\"100%\" " + svgPaint("fill", background) + "/>\n";
+}
+
+std::string Canvas::encodeSVG() const
+{
+    if (!recording)
+    {
+        return "";
+    }
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" + std::to_string(w) + "\" height=\"" + std::to_string(h) +
+           "\" viewBox=\"0 0 " + std::to_string(w) + " " + std::to_string(h) + "\" font-family=\"DejaVu Sans, sans-serif\" font-size=\"13\">\n" +
+           svg + "</svg>\n";
+}
@@ -0,0 +1,189 @@
+#include "catalog.h"
+#include "data.h"
+#include <algorithm>
+#include <atomic>
+
+std::shared_ptr<const Catalog> Catalog::load(const std::string &directory)
+{
+    auto catalog = std::make_shared<Catalog>();
+    for (const std::string &name : CATALOG_FILES)
+    {
+        catalog->loadFile(directory + "/" + name + ".json", name);
+    }
+    return catalog;
+}
+
+std::shared_ptr<const Catalog> Catalog::withReloadedFile(const std::string &directory, const std::string &name) const
+{
+    auto catalog = std::make_shared<Catalog>();
+    for (const std::string &file : CATALOG_FILES)
+    {
+        if (file == name)
+        {
+            if (!catalog->loadFile(directory + "/" + name + ".json", name))
+            {
+                return nullptr;
+            }
+            continue;
+        }
+
+        // Groups of the other files are copied from this catalog
+        for (const CatalogGroup &group : groupList)
+        {
+            if (group.catalog == file)
+            {
+                catalog->addGroup(group);
+            }
+        }
+    }
+    return catalog;
+}
+
+bool Catalog::loadFile(const std::string &path, const std::string &catalog)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Unable to open catalog file: " << path << std::endl;
+        return false;
+    }
+    std::string jsonData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    rapidjson::Document document;
+    document.Parse(jsonData.c_str());
+    if (!document.IsObject())
+    {
+        std::cerr << "Invalid JSON data in catalog file: " << path << std::endl;
+        return false;
+    }
+
+    // The groups are only added once the whole file turned out to be valid
+    std::vector<CatalogGroup> groups;
+    for (rapidjson::Value::ConstMemberIterator it = document.MemberBegin(); it != document.MemberEnd(); ++it)
+    {
+        if (!it->value.IsArray())
+        {
+            continue;
+        }
+
+        CatalogGroup group;
+        group.catalog = catalog;
+        group.key = it->name.GetString();
+        bool allDescriptions = true;
+        for (rapidjson::SizeType i = 0; i < it->value.Size(); ++i)
+        {
+            const rapidjson::Value &entry = it->value[i];
+            if (!entry.IsObject() || !entry.HasMember("symbol") || !entry.HasMember("name"))
+            {
+                continue;
+            }
+            if (!entry["symbol"].IsString() || !entry["name"].IsString() ||
+                (entry.HasMember("description") && !entry["description"].IsString()))
+            {
+                std::cerr << "Invalid entry in group \"" << group.key << "\" of catalog file: " << path << std::endl;
+                return false;
+            }
+
+            group.symbols.push_back(entry["symbol"].GetString());
+            group.names.push_back(entry["name"].GetString());
+            if (entry.HasMember("description"))
+            {
+                group.descriptions.push_back(entry["description"].GetString());
+            }
+            else
+            {
+                allDescriptions = false;
+            }
+        }
+        if (!allDescriptions)
+        {
+            group.descriptions.clear();
+        }
+        groups.push_back(std::move(group));
+    }
+
+    if (groups.empty())
+    {
+        std::cerr << "No groups in catalog file: " << path << std::endl;
+        return false;
+    }
+    for (CatalogGroup &group : groups)
+    {
+        addGroup(std::move(group));
+    }
+    return true;
+}
+
+void Catalog::addGroup(CatalogGroup group)
+{
+    index[group.catalog + "/" + group.key] = groupList.size();
+    groupList.push_back(std::move(group));
+}
+
+const CatalogGroup *Catalog::find(const std::string &catalog, const std::string &key) const
+{
+    auto it = index.find(catalog + "/" + key);
+    return (it == index.end()) ? nullptr : &groupList[it->second];
+}
+
+const std::vector<CatalogGroup> &Catalog::groups() const
+{
+    return groupList;
+}
+
+std::vector<std::string> Catalog::allSymbols() const
+{
+    std::vector<std::string> symbols;
+    for (const CatalogGroup &group : groupList)
+    {
+        for (const std::string &symbol : group.symbols)
+        {
+            if (std::find(symbols.begin(), symbols.end(), symbol) == symbols.end())
+            {
+                symbols.push_back(symbol);
+            }
+        }
+    }
+    return symbols;
+}
+
+std::uint64_t Catalog::generation() const
+{
+    return generationNumber;
+}
+
+std::uint64_t Catalog::nextGeneration()
+{
+    static std::atomic<std::uint64_t> generations{0};
+    return ++generations;
+}
+
+std::string getFormattedGroup(const Catalog &catalog, const std::string &name, const std::string &key, bool markdown,
+                              bool description, bool closedWarning, bool *marketOpen)
+{
+    if (markdown)
+    {
+        return closedWarning ? getFormattedGroup<Markdown, true>(catalog, name, key, description, marketOpen)
+                             : getFormattedGroup<Markdown, false>(catalog, name, key, description, marketOpen);
+    }
+    return closedWarning ? getFormattedGroup<PlainText, true>(catalog, name, key, description, marketOpen)
+                         : getFormattedGroup<PlainText, false>(catalog, name, key, description, marketOpen);
+}
+
+template <class Style, bool ClosedWarning>
+std::string getFormattedGroup(const Catalog &catalog, const std::string &name, const std::string &key, bool description, bool *marketOpen,
+                              const PriceProgress &progress, size_t *unavailable)
+{
+    const CatalogGroup *group = catalog.find(name, key);
+    if (!group)
+    {
+        return "Error: Invalid key.";
+    }
+    static const std::vector<std::string> noDescriptions;
+    return getFormattedPrices<Style, ClosedWarning>(group->symbols, group->names, description ? group->descriptions : noDescriptions, marketOpen, progress, unavailable);
+}
+
+template std::string getFormattedGroup<Markdown, false>(const Catalog &, const std::string &, const std::string &, bool, bool *, const PriceProgress &, size_t *);
+template std::string getFormattedGroup<Markdown, true>(const Catalog &, const std::string &, const std::string &, bool, bool *, const PriceProgress &, size_t *);
+template std::string getFormattedGroup<PlainText, false>(const Catalog &, const std::string &, const std::string &, bool, bool *, const PriceProgress &, size_t *);
+template std::string getFormattedGroup<PlainText, true>(const Catalog &, const std::string &, const std::string &, bool, bool *, const PriceProgress &, size_t *);
@@ -0,0 +1,146 @@
+#include "catalogwatcher.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <set>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Returns the catalog name of a file name (e.g. "indices" for "indices.json"), or an empty string for other files
+static std::string catalogName(const std::string &fileName)
+{
+    std::filesystem::path path(fileName);
+    if (path.extension() != ".json")
+    {
+        return "";
+    }
+    std::string name = path.stem().string();
+    return (std::find(CATALOG_FILES.begin(), CATALOG_FILES.end(), name) != CATALOG_FILES.end()) ? name : "";
+}
+
+CatalogWatcher::CatalogWatcher(const std::string &directory) : directory(directory), published(Catalog::load(directory))
+{
+}
+
+CatalogWatcher::~CatalogWatcher()
+{
+    stopping = true;
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+void CatalogWatcher::start()
+{
+    if (!thread.joinable())
+    {
+        thread = std::thread(&CatalogWatcher::watch, this);
+    }
+}
+
+std::shared_ptr<const Catalog> CatalogWatcher::current() const
+{
+    return std::atomic_load(&published);
+}
+
+bool CatalogWatcher::reload(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    std::shared_ptr<const Catalog> catalog = current()->withReloadedFile(directory, name);
+    if (!catalog)
+    {
+        std::cerr << "Catalog file " << name << ".json was not reloaded; the previous version stays in use." << std::endl;
+        return false;
+    }
+    std::atomic_store(&published, catalog);
+    std::cout << "Reloaded catalog file " << name << ".json" << std::endl;
+    return true;
+}
+
+void CatalogWatcher::watch()
+{
+#ifdef __linux__
+    // Editors either rewrite a file (close after writing) or replace it (move into the folder)
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0 && inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0)
+    {
+        alignas(inotify_event) char buffer[4096];
+        while (!stopping)
+        {
+            pollfd request{fd, POLLIN, 0};
+            if (poll(&request, 1, 1000) <= 0)
+            {
+                continue;
+            }
+
+            std::set<std::string> changed;
+            ssize_t length;
+            while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+            {
+                for (char *position = buffer; position < buffer + length;)
+                {
+                    const inotify_event *event = reinterpret_cast<const inotify_event *>(position);
+                    std::string name = (event->len > 0) ? catalogName(event->name) : "";
+                    if (!name.empty())
+                    {
+                        changed.insert(name);
+                    }
+                    position += sizeof(inotify_event) + event->len;
+                }
+            }
+            for (const std::string &name : changed)
+            {
+                reload(name);
+            }
+        }
+        close(fd);
+        return;
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    std::cerr << "Could not watch " << directory << " with inotify, checking modification times instead." << std::endl;
+#endif
+
+    // Fallback: compare the modification times of the catalog files
+    auto modificationTimes = [this]()
+    {
+        std::map<std::string, std::filesystem::file_time_type> times;
+        for (const std::string &name : CATALOG_FILES)
+        {
+            std::error_code error;
+            auto time = std::filesystem::last_write_time(directory + "/" + name + ".json", error);
+            if (!error)
+            {
+                times[name] = time;
+            }
+        }
+        return times;
+    };
+
+    auto known = modificationTimes();
+    while (!stopping)
+    {
+        for (auto waited = std::chrono::milliseconds(0); waited < CATALOG_POLL_INTERVAL && !stopping; waited += std::chrono::milliseconds(250))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        }
+
+        auto times = modificationTimes();
+        for (const auto &[name, time] : times)
+        {
+            auto previous = known.find(name);
+            if (previous == known.end() || previous->second != time)
+            {
+                reload(name);
+            }
+        }
+        known = times;
+    }
+}
@@ -0,0 +1,264 @@
+#include "commands.h"
+#include "quotecache.h"
+#include "symbolindex.h"
+#include "visualize.h"
+#include <cctype>
+
+// Message of commands with a period that cannot be parsed
+static const char *INVALID_PERIOD = "Invalid period format. Examples of supported formats: 7mo, 1w, 3y, 6d, "
+                                    "where mo = month, w = week, y = year, and d = day.";
+
+// Returns the value of an option, or an empty string if it was not given
+static std::string option(const CommandOptions &options, const std::string &name)
+{
+    auto it = options.find(name);
+    return (it != options.end()) ? it->second : "";
+}
+
+// Returns the symbol option; names are turned into symbols with the symbol index
+static std::string symbolOption(const CommandOptions &options)
+{
+    return SymbolIndex::instance().resolve(option(options, "symbol"));
+}
+
+// Returns a reply with text only
+static CommandReply textReply(std::string content)
+{
+    CommandReply reply;
+    reply.content = std::move(content);
+    return reply;
+}
+
+// Returns a reply with a chart
+static CommandReply chartReply(const std::string &content, const std::string &baseName, std::string image)
+{
+    ImageFormat format = getImageOptions().format;
+    CommandReply reply;
+    reply.content = content;
+    reply.fileName = baseName + "." + imageFileExtension(format);
+    reply.fileContents = std::move(image);
+    reply.fileMimeType = imageMimeType(format);
+    return reply;
+}
+
+// Returns how a period is written in the /movements reply (e.g. "in the last 3 months")
+static std::string describePeriod(const std::string &period)
+{
+    // Extract numeric and non-numeric parts of the period
+    std::string numericPart = "";
+    std::string nonNumericPart = "";
+    for (char c : period)
+    {
+        if (isdigit(c))
+        {
+            numericPart += c;
+        }
+        else
+        {
+            nonNumericPart += c;
+        }
+    }
+
+    int timeValue = std::stoi(numericPart);
+    char periodType = nonNumericPart[0];
+
+    // Construct the period string for the message
+    std::string periodDescription;
+    if (periodType == 'y')
+    {
+        periodDescription = (timeValue == 1) ? "in the last year" : "in the last " + std::to_string(timeValue) + " years";
+    }
+    else if (periodType == 'm')
+    {
+        periodDescription = (timeValue == 1) ? "in the last month" : "in the last " + std::to_string(timeValue) + " months";
+    }
+    else if (periodType == 'w')
+    {
+        periodDescription = "in the last " + std::to_string(timeValue) + " weeks";
+    }
+    else if (periodType == 'd')
+    {
+        periodDescription = "in the last " + std::to_string(timeValue) + " days";
+    }
+    return periodDescription;
+}
+
+// Returns a builder of the response cache for the reply with the prices of a catalog group
+static ResponseCache::Builder groupReply(const CommandHandler::CatalogSource &catalog, const std::string &name, const std::string &key)
+{
+    return [catalog, name, key](bool &marketOpen, bool &complete)
+    {
+        size_t unavailable = 0;
+        std::string reply = getFormattedGroup<Markdown, true>(*catalog(), name, key, false, &marketOpen, nullptr, &unavailable);
+        complete = (unavailable == 0);
+        return reply;
+    };
+}
+
+CommandHandler::CommandHandler(CatalogSource catalog) : catalog(std::move(catalog))
+{
+    responseCache.add("commodities", groupReply(this->catalog, "commodities", "commodities"));
+    responseCache.add("currencies", groupReply(this->catalog, "currencies", "currencies"));
+    responseCache.add("crypto", groupReply(this->catalog, "currencies", "cryptocurrencies"));
+}
+
+bool CommandHandler::isProgressive(const std::string &command, const CommandOptions &options) const
+{
+    std::shared_ptr<const Catalog> current = catalog();
+    const CatalogGroup *group = nullptr;
+    if (command == "majorindices")
+    {
+        group = current->find("indices", option(options, "region"));
+    }
+    else if (command == "industries")
+    {
+        group = current->find("industries", option(options, "industry"));
+    }
+    return group && !QuoteCache::instance().expiring(group->symbols, std::chrono::seconds(0)).empty();
+}
+
+CommandReply CommandHandler::execute(const std::string &command, const CommandOptions &options, const PriceProgress &progress)
+{
+    syncSymbolIndex(); // Names typed as symbols are resolved with the index
+
+    if (command == "latestprice")
+    {
+        return textReply(getFormattedPrice<Markdown, true>(symbolOption(options)));
+    }
+    else if (command == "pricegraph")
+    {
+        std::string symbol = symbolOption(options);
+        std::string period = option(options, "period");
+        std::string mode = option(options, "mode");
+
+        // Get name of symbol (this will be added to the message instead of just adding the symbol)
+        Metrics metrics = fetchMetrics(symbol);
+        std::string name = metrics.name;
+
+        // Check if duration is valid and not too short, and add note if it is too short
+        std::time_t duration = getDurationInSeconds(period);
+        std::string note = "";
+        if (duration == 0)
+        {
+            return textReply(INVALID_PERIOD);
+        }
+        if (duration < 259200)
+        {
+            period = "3 days";
+            note = "Note: period has been set to 3 days, because periods shorter than 3 days may result in an empty graph";
+        }
+
+        // Create graph (returns once the image is fully rendered)
+        std::string image = priceGraph(symbol, period, std::stoi(mode));
+        if (image.empty())
+        {
+            return textReply("Oops! Something went wrong while creating the graph.");
+        }
+        return chartReply("### Price Graph for " + name + "\n" + note, "price_graph", std::move(image));
+    }
+    else if (command == "candlestick")
+    {
+        std::string symbol = symbolOption(options);
+        std::string period = option(options, "period");
+        std::string showV = option(options, "volume");
+
+        // Get name of symbol (this will be added to the message instead of just adding the symbol)
+        Metrics metrics = fetchMetrics(symbol);
+        std::string name = metrics.name;
+
+        // Check if duration is valid
+        if (getDurationInSeconds(period) == 0)
+        {
+            return textReply(INVALID_PERIOD);
+        }
+
+        // Create candlestick chart (returns once the image is fully rendered); the note tells if candles were merged
+        std::string note = "";
+        std::string image = createCandleChart(symbol, period, showV != "n", &note);
+        if (image.empty())
+        {
+            return textReply("Oops! Something went wrong while creating the candlestick chart.");
+        }
+        return chartReply("### Candlestick chart for " + name + "\n" + note, "candle_chart", std::move(image));
+    }
+    else if (command == "metrics")
+    {
+        return textReply(getFormattedMetrics<Markdown>(symbolOption(options)));
+    }
+    else if (command == "majorindices")
+    {
+        bool showDesc = (option(options, "description") == "n") ? false : true;
+        return textReply(getFormattedGroup<Markdown, true>(*catalog(), "indices", option(options, "region"), showDesc, nullptr, progress));
+    }
+    else if (command == "commodities" || command == "currencies" || command == "crypto")
+    {
+        CommandReply reply;
+        responseCache.get(command, reply.content);
+        return reply;
+    }
+    else if (command == "industries")
+    {
+        return textReply(getFormattedGroup<Markdown, true>(*catalog(), "industries", option(options, "industry"), false, nullptr, progress));
+    }
+    else if (command == "search")
+    {
+        std::string name = option(options, "name");
+        std::vector<SearchResult> results = SymbolIndex::instance().search(name);
+        if (results.empty())
+        {
+            return textReply("No symbols found for \"" + name + "\".");
+        }
+
+        std::string reply = "### Symbols matching \"" + name + "\"\n";
+        for (const SearchResult &result : results)
+        {
+            reply += "- `" + result.match.symbol + "` " + result.match.name + "\n";
+        }
+        return textReply(reply);
+    }
+    else if (command == "movements")
+    {
+        std::string symbol = symbolOption(options);
+        std::string period = option(options, "period");
+
+        // Get name of symbol (this will be added to the message instead of just adding the symbol)
+        Metrics metrics = fetchMetrics(symbol);
+        std::string name = metrics.name;
+
+        // Check if duration is valid, and not too short
+        std::time_t duration = getDurationInSeconds(period);
+        std::string note = "";
+        if (duration == 0)
+        {
+            return textReply(INVALID_PERIOD);
+        }
+        if (duration < 2592000)
+        {
+            note = "Note: the period provided was too short and has therefore been set to one month.";
+        }
+
+        // Get top 5 biggest gains and losses (in % change)
+        std::string result = getFormattedGainsLosses<Markdown>(symbol, period);
+        if (result.empty())
+        {
+            return CommandReply();
+        }
+        return textReply("### Biggest gains and losses for " + name + " " + describePeriod(period) + "\n" + note + "\n" + result);
+    }
+    return CommandReply();
+}
+
+void CommandHandler::syncSymbolIndex()
+{
+    // The index is brought up to date when the catalog has been reloaded
+    std::shared_ptr<const Catalog> current = catalog();
+    if (indexedGeneration.exchange(current->generation()) != current->generation())
+    {
+        SymbolIndex::instance().addCatalog(*current);
+    }
+}
+
+ResponseCache &CommandHandler::responses()
+{
+    return responseCache;
+}
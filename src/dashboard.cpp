@@ -0,0 +1,56 @@
+#include "dashboard.h"
+#include "visualize.h"
+#include <algorithm>
+#include <thread>
+
+DashboardScheduler::DashboardScheduler(CatalogSource catalogSource, std::vector<std::string> catalogs, std::vector<DashboardChart> charts)
+    : catalogSource(std::move(catalogSource)), catalogs(std::move(catalogs)), charts(std::move(charts))
+{
+}
+
+void DashboardScheduler::start(dpp::cluster &bot)
+{
+    renderInBackground();
+    bot.start_timer([this](dpp::timer)
+                    { renderInBackground(); }, DASHBOARD_INTERVAL.count());
+}
+
+void DashboardScheduler::renderInBackground()
+{
+    // Rendering all charts takes a while, so it never runs on the timer thread
+    if (rendering.exchange(true))
+    {
+        return;
+    }
+    std::thread([this]()
+                {
+                    renderAll();
+                    rendering = false; })
+        .detach();
+}
+
+size_t DashboardScheduler::renderAll()
+{
+    // Charts stay fresh a bit longer than the interval, so they do not expire before the next round has redrawn them
+    std::chrono::seconds freshFor = DASHBOARD_INTERVAL + DASHBOARD_INTERVAL / 2;
+    size_t rendered = 0;
+    std::shared_ptr<const Catalog> catalog = catalogSource();
+    for (const CatalogGroup &group : catalog->groups())
+    {
+        if (std::find(catalogs.begin(), catalogs.end(), group.catalog) == catalogs.end())
+        {
+            continue;
+        }
+
+        for (const std::string &symbol : group.symbols)
+        {
+            for (const DashboardChart &chart : charts)
+            {
+                bool created = chart.candlestick ? prerenderCandleChart(symbol, chart.period, chart.withVolume, freshFor)
+                                                 : prerenderPriceGraph(symbol, chart.period, chart.mode, freshFor);
+                rendered += created ? 1 : 0;
+            }
+        }
+    }
+    return rendered;
+}
@@ -1,4 +1,26 @@
 #include "data.h"
+#include <array>
+#include "sharedcache.h"
+#include "quotecache.h"
+#include "symbolindex.h"
+#include "telemetry.h"
+
+// Base URL of the Yahoo Finance requests
+static std::string upstream = DEFAULT_UPSTREAM_URL;
+
+void setUpstreamUrl(const std::string &url)
+{
+    upstream = url;
+    while (!upstream.empty() && upstream.back() == '/')
+    {
+        upstream.pop_back();
+    }
+}
+
+const std::string &upstreamUrl()
+{
+    return upstream;
+}
 
 static size_t WriteCallback(char *ptr, size_t size, size_t nmemb, std::string *userdata)
 {
@@ -47,30 +69,184 @@ std::time_t convertToUnixTimestamp(const std::string &date)
     return timestamp;
 }
 
+// Returns the kind of Yahoo Finance endpoint of a URL (label of the upstream metrics)
+static const char *endpointType(const std::string &url)
+{
+    if (url.find("/finance/options/") != std::string::npos)
+    {
+        return "quote";
+    }
+    if (url.find("/finance/download/") != std::string::npos)
+    {
+        return "history";
+    }
+    return "other";
+}
+
+// Counts a failed upstream request (transport error or HTTP error status)
+static void countUpstreamError(const std::string &url, const char *reason)
+{
+    Telemetry::instance().increment("equity_upstream_errors_total", std::string("endpoint=\"") + endpointType(url) + "\",reason=\"" + reason + "\"");
+}
+
+// Returns the host of a URL (e.g. "query1.finance.yahoo.com")
+static std::string urlHost(const std::string &url)
+{
+    size_t start = url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    size_t end = url.find_first_of(":/?", start);
+    return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+// Records the timing of a finished transfer per host and endpoint (DNS, connect, TLS, first byte, total, bytes)
+static void recordTransfer(CURL *curl)
+{
+    char *url = nullptr;
+    curl_off_t nameLookup = 0, connect = 0, tlsHandshake = 0, firstByte = 0, total = 0, bytes = 0;
+    long connections = 0;
+    curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url);
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &tlsHandshake);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &firstByte);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &bytes);
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &connections);
+
+    // curl reports the times in microseconds since the start of the transfer
+    TransferTiming timing;
+    timing.host = urlHost(url ? url : "");
+    timing.endpoint = endpointType(url ? url : "");
+    timing.nameLookup = std::chrono::microseconds(nameLookup);
+    timing.connect = std::chrono::microseconds(connect);
+    timing.tlsHandshake = std::chrono::microseconds(tlsHandshake);
+    timing.firstByte = std::chrono::microseconds(firstByte);
+    timing.total = std::chrono::microseconds(total);
+    timing.bytes = static_cast<uint64_t>(bytes);
+    timing.reusedConnection = (connections == 0);
+    Telemetry::instance().recordTransfer(timing);
+}
+
+// Sets the options shared by all Yahoo Finance requests
+static void setRequestOptions(CURL *curl, const std::string &url, std::string *response)
+{
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    // Set the User-Agent header
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/122.0.0.0 Safari/537.36");
+    // Set the callback function to handle the response data, and the string to write the response data to
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, response);
+    // Give up on requests that stall (no signals, so the timeouts also work outside the main thread)
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(UPSTREAM_CONNECT_TIMEOUT.count()));
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(UPSTREAM_TIMEOUT.count()));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+}
+
 std::string httpGet(const std::string& url) {
+    StageTimer timer("fetch");
     CURL* curl;
     CURLcode res;
     std::string readBuffer;
 
     curl = curl_easy_init();
     if(curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        // Set the User-Agent header
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/122.0.0.0 Safari/537.36");
-        // Set the callback function to handle the response data
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        // Pass the string to write the response data to
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
+        setRequestOptions(curl, url, &readBuffer);
 
         res = curl_easy_perform(curl);
+        long status = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
         if(res != CURLE_OK) {
             std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
+            countUpstreamError(url, "transport");
+        }
+        else if(status >= 400) {
+            countUpstreamError(url, "http");
+        }
+        if(res == CURLE_OK) {
+            recordTransfer(curl);
         }
         curl_easy_cleanup(curl);
     }
     return readBuffer;
 }
 
+std::vector<std::string> httpGetBatch(const std::vector<std::string> &urls, long maxConnections)
+{
+    StageTimer timer("fetch");
+    std::vector<std::string> responses(urls.size());
+    CURLM *multi = curl_multi_init();
+    if (!multi)
+    {
+        return responses;
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxConnections);
+
+    std::vector<CURL *> handles;
+    for (size_t i = 0; i < urls.size(); i++)
+    {
+        CURL *curl = curl_easy_init();
+        if (!curl)
+        {
+            continue;
+        }
+        setRequestOptions(curl, urls[i], &responses[i]);
+        curl_multi_add_handle(multi, curl);
+        handles.push_back(curl);
+    }
+
+    // Run all transfers; curl queues the ones above the connection limit
+    int running = 0;
+    do
+    {
+        CURLMcode code = curl_multi_perform(multi, &running);
+        if (code != CURLM_OK)
+        {
+            std::cerr << "curl_multi_perform() failed: " << curl_multi_strerror(code) << std::endl;
+            break;
+        }
+        if (running)
+        {
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+    } while (running);
+
+    // Record the timing of the transfers and report the failed ones (their responses stay empty or incomplete)
+    CURLMsg *message;
+    int remaining;
+    while ((message = curl_multi_info_read(multi, &remaining)))
+    {
+        if (message->msg != CURLMSG_DONE)
+        {
+            continue;
+        }
+        char *url = nullptr;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_EFFECTIVE_URL, &url);
+        long status = 0;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_RESPONSE_CODE, &status);
+        if (message->data.result != CURLE_OK)
+        {
+            std::cerr << "curl transfer failed: " << curl_easy_strerror(message->data.result) << std::endl;
+            countUpstreamError(url ? url : "", "transport");
+        }
+        else if (status >= 400)
+        {
+            countUpstreamError(url ? url : "", "http");
+        }
+        if (message->data.result == CURLE_OK)
+        {
+            recordTransfer(message->easy_handle);
+        }
+    }
+
+    for (CURL *curl : handles)
+    {
+        curl_multi_remove_handle(multi, curl);
+        curl_easy_cleanup(curl);
+    }
+    curl_multi_cleanup(multi);
+    return responses;
+}
+
 std::vector<std::vector<std::string>> fetchOHLCData(const std::string &symbol, const std::string &duration)
 {
     // Define the current timestamp as the end time
@@ -91,12 +267,18 @@ std::vector<std::vector<std::string>> fetchOHLCData(const std::string &symbol, c
     endTimestamp << endTime;
 
     // Build the URL for historical data
-    std::string url = "https://query1.finance.yahoo.com/v7/finance/download/" + symbol +
+    std::string url = upstream + "/v7/finance/download/" + symbol +
                       "?period1=" + startTimestamp.str() + "&period2=" + endTimestamp.str() +
                       "&interval=1d&events=history";
 
-    // Fetch historical price data using the URL
-    std::string response = httpGet(url);
+    // Fetch historical price data using the URL (or take it from the shared cache if another process fetched it recently)
+    SharedCache *sharedCache = SharedCache::instance();
+    std::string response;
+    bool cached = sharedCache && sharedCache->readOHLC(symbol, endTime - startTime, response);
+    if (!cached)
+    {
+        response = httpGet(url);
+    }
 
     // Check if response contains an error or is empty
     if (response.find("404 Not Found: No data found, symbol may be delisted") != std::string::npos)
@@ -110,8 +292,21 @@ std::vector<std::vector<std::string>> fetchOHLCData(const std::string &symbol, c
         return std::vector<std::vector<std::string>>();
     }
 
+    std::vector<std::vector<std::string>> ohlcData = parseOHLCData(response);
+
+    if (sharedCache && !cached && !ohlcData.empty())
+    {
+        sharedCache->writeOHLC(symbol, endTime - startTime, response);
+    }
+
+    return ohlcData;
+}
+
+std::vector<std::vector<std::string>> parseOHLCData(const std::string &csv)
+{
     // Parse the CSV response and store OHLC data in a 2D vector
-    std::istringstream ss(response);
+    StageTimer timer("parse");
+    std::istringstream ss(csv);
     std::string line;
 
     // Skip the header line
@@ -140,6 +335,16 @@ std::vector<std::vector<std::string>> fetchOHLCData(const std::string &symbol, c
 }
 
 std::string getFormattedPrice(const std::string &symbol, bool markdown, bool closedWarning)
+{
+    if (markdown)
+    {
+        return closedWarning ? getFormattedPrice<Markdown, true>(symbol) : getFormattedPrice<Markdown, false>(symbol);
+    }
+    return closedWarning ? getFormattedPrice<PlainText, true>(symbol) : getFormattedPrice<PlainText, false>(symbol);
+}
+
+template <class Style, bool ClosedWarning>
+std::string getFormattedPrice(const std::string &symbol)
 {
     // Fetch data
     Metrics data = fetchMetrics(symbol);
@@ -150,53 +355,72 @@ std::string getFormattedPrice(const std::string &symbol, bool markdown, bool clo
         return "Could not fetch latest price data. Symbol may be invalid.";
     }
 
-    // Create the formatted string with the result
-    std::ostringstream resultStream;
-    if (!markdown)
+    return formatPrice<Style, ClosedWarning>(data);
+}
+
+// Appends the price, currency and % change of a quote; in Markdown as a code span followed by a trend emoji
+template <class Style>
+static void appendQuote(TextBuffer &result, const Metrics &data)
+{
+    result.append(Style::code).appendGrouped(data.latestPrice).append(' ').append(data.currency)
+          .append(" (").appendSigned(data.latestChange).append("%)").append(Style::code);
+    if constexpr (Style::markdown)
     {
-        resultStream << "Latest Price for " << data.name << ": " << std::fixed << std::setprecision(2) << data.latestPrice << " " << data.currency
-                     << " (" << (data.latestChange >= 0 ? "+" : "") << std::fixed << std::setprecision(2) << data.latestChange << "%)";
-        if (closedWarning == true && data.marketState != "REGULAR") // Add note if market is not open
-        {
-            resultStream << " *Market is currently closed*" << std::endl;
-        }
-        else
-        {
-            resultStream << "\n"; // closedWarning adds new line, so in case of no warning, add close line here
-        }
+        result.append(data.latestChange >= 0 ? ":chart_with_upwards_trend:" : ":chart_with_downwards_trend:");
+    }
+}
+
+// Appends the note for a closed market (if requested) and ends the line
+template <bool ClosedWarning>
+static void appendClosedWarning(TextBuffer &result, const Metrics &data)
+{
+    if (ClosedWarning && data.marketState != "REGULAR") // Add note if market is not open
+    {
+        result.append(" *Market is currently closed*\n");
     }
     else
     {
-        resultStream << "### Latest Price for " << data.name << "\n`" << std::fixed << std::setprecision(2) << data.latestPrice << " " << data.currency;
-        
-        if (data.latestChange >= 0)
-        {
-            resultStream << " (+" << std::fixed << std::setprecision(2) << data.latestChange << "%)`:chart_with_upwards_trend:";
-        }
-        else
-        {
-            resultStream << " (" << std::fixed << std::setprecision(2) << data.latestChange << "%)`:chart_with_downwards_trend:";
-        }
+        result.append('\n'); // closedWarning adds new line, so in case of no warning, add close line here
+    }
+}
 
-        if (closedWarning == true && data.marketState != "REGULAR") // Add note if market is not open
+template <class Style, bool ClosedWarning>
+std::string formatPrice(const Metrics &data)
+{
+    TextBuffer &result = formatBuffer();
+    if constexpr (Style::markdown)
+    {
+        result.append("### Latest Price for ").append(data.name).append('\n');
+        appendQuote<Style>(result, data);
+        if (ClosedWarning && data.marketState != "REGULAR") // Add note if market is not open
         {
-            resultStream << " *Market is currently closed*" << std::endl;
+            result.append(" *Market is currently closed*\n");
         }
     }
+    else
+    {
+        result.append("Latest Price for ").append(data.name).append(": ");
+        appendQuote<Style>(result, data);
+        appendClosedWarning<ClosedWarning>(result, data);
+    }
 
-    return resultStream.str();
+    return result.str();
 }
 
-Metrics fetchMetrics(const std::string &symbol)
+template std::string getFormattedPrice<Markdown, false>(const std::string &symbol);
+template std::string getFormattedPrice<Markdown, true>(const std::string &symbol);
+template std::string getFormattedPrice<PlainText, false>(const std::string &symbol);
+template std::string getFormattedPrice<PlainText, true>(const std::string &symbol);
+template std::string formatPrice<Markdown, false>(const Metrics &data);
+template std::string formatPrice<Markdown, true>(const Metrics &data);
+template std::string formatPrice<PlainText, false>(const Metrics &data);
+template std::string formatPrice<PlainText, true>(const Metrics &data);
+
+Metrics parseMetrics(const std::string &symbol, const std::string &response)
 {
+    StageTimer timer("parse");
     Metrics equityMetrics;
 
-    // Construct the Yahoo Finance API URL with the symbol
-    std::string apiUrl = "https://query1.finance.yahoo.com/v6/finance/options/" + symbol;
-
-    // Fetch data from the Yahoo Finance API
-    std::string response = httpGet(apiUrl);
-
     // Check if response contains an error or is empty
     if (response.find("{\"optionChain\":{\"result\":[],\"error\":null}}") != std::string::npos)
     {
@@ -296,7 +520,95 @@ Metrics fetchMetrics(const std::string &symbol)
     return equityMetrics;
 }
 
+// Stores a valid quote in the quote cache and makes its symbol available for autocompletion
+static void storeQuote(const std::string &symbol, const Metrics &metrics)
+{
+    QuoteCache::instance().put(symbol, metrics);
+    SymbolIndex::instance().add(metrics.symbol, metrics.name);
+}
+
+Metrics fetchMetrics(const std::string &symbol)
+{
+    Metrics equityMetrics;
+
+    // Quotes of the catalog symbols are kept fresh in this process by the QuoteRefresher
+    if (QuoteCache::instance().get(symbol, equityMetrics))
+    {
+        Telemetry::instance().increment("equity_cache_requests_total", "cache=\"quote\",result=\"hit\"");
+        return equityMetrics;
+    }
+    Telemetry::instance().increment("equity_cache_requests_total", "cache=\"quote\",result=\"miss\"");
+
+    // Use the shared cache if this process is attached to one
+    SharedCache *sharedCache = SharedCache::instance();
+    if (sharedCache && sharedCache->readQuote(symbol, equityMetrics))
+    {
+        Telemetry::instance().increment("equity_cache_requests_total", "cache=\"shared\",result=\"hit\"");
+        storeQuote(symbol, equityMetrics);
+        return equityMetrics;
+    }
+
+    // Construct the Yahoo Finance API URL with the symbol and fetch the data
+    std::string apiUrl = upstream + "/v6/finance/options/" + symbol;
+    equityMetrics = parseMetrics(symbol, httpGet(apiUrl));
+
+    if (equityMetrics.symbol != "-")
+    {
+        storeQuote(symbol, equityMetrics);
+        if (sharedCache)
+        {
+            sharedCache->writeQuote(symbol, equityMetrics);
+        }
+    }
+
+    return equityMetrics;
+}
+
+std::vector<Metrics> fetchMetricsBatch(const std::vector<std::string> &symbols)
+{
+    std::vector<Metrics> results(symbols.size());
+    SharedCache *sharedCache = SharedCache::instance();
+
+    // Quotes that another process has fetched recently are taken from the shared cache
+    std::vector<size_t> pending;
+    std::vector<std::string> urls;
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+        if (sharedCache && sharedCache->readQuote(symbols[i], results[i]))
+        {
+            storeQuote(symbols[i], results[i]);
+            continue;
+        }
+        pending.push_back(i);
+        urls.push_back(upstream + "/v6/finance/options/" + symbols[i]);
+    }
+
+    // The others are fetched concurrently
+    std::vector<std::string> responses = httpGetBatch(urls);
+    for (size_t k = 0; k < pending.size(); k++)
+    {
+        size_t i = pending[k];
+        results[i] = parseMetrics(symbols[i], responses[k]);
+        if (results[i].symbol != "-")
+        {
+            storeQuote(symbols[i], results[i]);
+            if (sharedCache)
+            {
+                sharedCache->writeQuote(symbols[i], results[i]);
+            }
+        }
+    }
+
+    return results;
+}
+
 std::string getFormattedMetrics(const std::string &symbol, bool markdown)
+{
+    return markdown ? getFormattedMetrics<Markdown>(symbol) : getFormattedMetrics<PlainText>(symbol);
+}
+
+template <class Style>
+std::string getFormattedMetrics(const std::string &symbol)
 {
     // Fetch metrics for the given symbol
     Metrics metrics = fetchMetrics(symbol);
@@ -307,152 +619,179 @@ std::string getFormattedMetrics(const std::string &symbol, bool markdown)
         return "Could not fetch data. Symbol may be invalid.";
     }
 
-    // Create a string stream to hold the formatted metrics
-    std::ostringstream formattedMetrics;
-
-    // Format the metrics
-    if (!markdown)
-    {
-        formattedMetrics << "Metrics for " << metrics.name << ":\n";
-        formattedMetrics << std::fixed << std::setprecision(2);
-        formattedMetrics << "- Market Cap:         " << metrics.marketCap << " " << metrics.currency << "\n";
-        formattedMetrics << "- P/E Ratio:          " << metrics.peRatio << "\n";
-        formattedMetrics << "- Latest Price:       " << metrics.latestPrice << " " << metrics.currency << "\n";
-        formattedMetrics << "- Open price:         " << metrics.openPrice << " " << metrics.currency << "\n";
-        formattedMetrics << "- Day Low:            " << metrics.dayLow << " " << metrics.currency << "\n";
-        formattedMetrics << "- Day High:           " << metrics.dayHigh << " " << metrics.currency << "\n";
-        formattedMetrics << "- Previous Close:     " << metrics.prevClose << " " << metrics.currency << "\n";
-        formattedMetrics << "- 52 Week Low:        " << metrics.fiftyTwoWeekLow << " " << metrics.currency << "\n";
-        formattedMetrics << "- 52 Week High:       " << metrics.fiftyTwoWeekHigh << " " << metrics.currency << "\n";
-        formattedMetrics << "- 50 Day avg:         " << metrics.avg_50 << " " << metrics.currency << "\n";
-        formattedMetrics << "- 200 Day avg:        " << metrics.avg_200 << " " << metrics.currency << "\n";
-        formattedMetrics << std::fixed << std::setprecision(0); // For average volume no need for decimal places
-        formattedMetrics << "- 3 Month Volume avg: " << metrics.avgVol_3mo << "\n";
-    }
-    else // It looks weird but this way in Discord the spaces between the names and values are even
-    {
-        formattedMetrics << "### Metrics for " << metrics.name << "\n";
-        formattedMetrics << std::fixed << std::setprecision(2);
-        formattedMetrics << "- Market Cap:                          `" << metrics.marketCap << " " << metrics.currency << "`\n";
-        formattedMetrics << "- P/E Ratio:                              `" << metrics.peRatio << "`\n";
-        formattedMetrics << "- Latest Price:                         `" << metrics.latestPrice << " " << metrics.currency << "`\n";
-        formattedMetrics << "- Open price:                           `" << metrics.openPrice << " " << metrics.currency << "`\n";
-        formattedMetrics << "- Day Low:                                `" << metrics.dayLow << " " << metrics.currency << "`\n";
-        formattedMetrics << "- Day High:                               `" << metrics.dayHigh << " " << metrics.currency << "`\n";
-        formattedMetrics << "- Previous Close:                    `" << metrics.prevClose << " " << metrics.currency << "`\n";
-        formattedMetrics << "- 52 Week Low:                       `" << metrics.fiftyTwoWeekLow << " " << metrics.currency << "`\n";
-        formattedMetrics << "- 52 Week High:                      `" << metrics.fiftyTwoWeekHigh << " " << metrics.currency << "`\n";
-        formattedMetrics << "- 50 Day avg:                           `" << metrics.avg_50 << " " << metrics.currency << "`\n";
-        formattedMetrics << "- 200 Day avg:                         `" << metrics.avg_200 << " " << metrics.currency << "`\n";
-        formattedMetrics << std::fixed << std::setprecision(0); // For average volume no need for decimal places
-        formattedMetrics << "- 3 Month Volume avg:         `" << metrics.avgVol_3mo << "`\n";
-    }
-
-    // Return the formatted metrics as a string
-    return formattedMetrics.str();
-}
-
-std::string getFormattedPrices(std::vector<std::string> symbols, std::vector<std::string> names, std::vector<std::string> descriptions, bool markdown, bool closedWarning)
+    return formatMetrics<Style>(metrics);
+}
+
+// Labels of the lines of the metrics reply. The Markdown labels look weird but this way in Discord
+// the spaces between the names and values are even
+template <class Style>
+struct MetricLabels;
+
+template <>
+struct MetricLabels<PlainText>
 {
-    // Check if data is available
-    if (symbols.empty())
+    static constexpr std::string_view title = "Metrics for ";
+    static constexpr std::string_view titleEnd = ":\n";
+    static constexpr std::string_view marketCap = "- Market Cap:         ";
+    static constexpr std::string_view peRatio = "- P/E Ratio:          ";
+    static constexpr std::string_view volume = "- 3 Month Volume avg: ";
+    static constexpr std::array<std::string_view, 9> prices = {
+        "- Latest Price:       ", "- Open price:         ", "- Day Low:            ",
+        "- Day High:           ", "- Previous Close:     ", "- 52 Week Low:        ",
+        "- 52 Week High:       ", "- 50 Day avg:         ", "- 200 Day avg:        "};
+};
+
+template <>
+struct MetricLabels<Markdown>
+{
+    static constexpr std::string_view title = "### Metrics for ";
+    static constexpr std::string_view titleEnd = "\n";
+    static constexpr std::string_view marketCap = "- Market Cap:                          ";
+    static constexpr std::string_view peRatio = "- P/E Ratio:                              ";
+    static constexpr std::string_view volume = "- 3 Month Volume avg:         ";
+    static constexpr std::array<std::string_view, 9> prices = {
+        "- Latest Price:                         ", "- Open price:                           ", "- Day Low:                                ",
+        "- Day High:                               ", "- Previous Close:                    ", "- 52 Week Low:                       ",
+        "- 52 Week High:                      ", "- 50 Day avg:                           ", "- 200 Day avg:                         "};
+};
+
+// The prices of the metrics reply, in the order of MetricLabels::prices
+static constexpr std::array<double Metrics::*, 9> METRIC_PRICES = {
+    &Metrics::latestPrice, &Metrics::openPrice, &Metrics::dayLow, &Metrics::dayHigh, &Metrics::prevClose,
+    &Metrics::fiftyTwoWeekLow, &Metrics::fiftyTwoWeekHigh, &Metrics::avg_50, &Metrics::avg_200};
+
+template <class Style>
+std::string formatMetrics(const Metrics &metrics)
+{
+    using Labels = MetricLabels<Style>;
+    TextBuffer &result = formatBuffer();
+
+    result.append(Labels::title).append(metrics.name).append(Labels::titleEnd);
+    result.append(Labels::marketCap).append(Style::code).appendCompact(metrics.marketCap).append(' ').append(metrics.currency).append(Style::code).append('\n');
+    result.append(Labels::peRatio).append(Style::code).appendFixed(metrics.peRatio).append(Style::code).append('\n');
+    for (size_t i = 0; i < METRIC_PRICES.size(); i++)
     {
-        return "No data available.";
+        result.append(Labels::prices[i]).append(Style::code).appendGrouped(metrics.*METRIC_PRICES[i]).append(' ').append(metrics.currency).append(Style::code).append('\n');
     }
+    result.append(Labels::volume).append(Style::code).appendGrouped(metrics.avgVol_3mo, 0).append(Style::code).append('\n'); // For average volume no need for decimal places
 
-    // Check if there are names and descriptions available
-    bool addNames = false;
-    bool addDescription = false;
-    if ((!names.empty()) && (names.size() == symbols.size()))
+    return result.str();
+}
+
+template std::string getFormattedMetrics<Markdown>(const std::string &symbol);
+template std::string getFormattedMetrics<PlainText>(const std::string &symbol);
+template std::string formatMetrics<Markdown>(const Metrics &metrics);
+template std::string formatMetrics<PlainText>(const Metrics &metrics);
+
+// Returns the metrics of the symbols: valid quotes from the quote cache, the others are fetched concurrently
+static std::vector<Metrics> resolveMetrics(const std::vector<std::string> &symbols)
+{
+    std::vector<Metrics> results(symbols.size());
+    std::vector<size_t> missing;
+    std::vector<std::string> missingSymbols;
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+        if (!QuoteCache::instance().get(symbols[i], results[i]))
+        {
+            missing.push_back(i);
+            missingSymbols.push_back(symbols[i]);
+        }
+    }
+
+    if (!missingSymbols.empty())
+    {
+        std::vector<Metrics> fetched = fetchMetricsBatch(missingSymbols);
+        for (size_t k = 0; k < missing.size(); k++)
+        {
+            results[missing[k]] = fetched[k];
+        }
+    }
+    return results;
+}
+
+std::string getFormattedPrices(std::vector<std::string> symbols, std::vector<std::string> names, std::vector<std::string> descriptions, bool markdown, bool closedWarning, bool *marketOpen)
+{
+    if (markdown)
+    {
+        return closedWarning ? getFormattedPrices<Markdown, true>(symbols, names, descriptions, marketOpen)
+                             : getFormattedPrices<Markdown, false>(symbols, names, descriptions, marketOpen);
+    }
+    return closedWarning ? getFormattedPrices<PlainText, true>(symbols, names, descriptions, marketOpen)
+                         : getFormattedPrices<PlainText, false>(symbols, names, descriptions, marketOpen);
+}
+
+template <class Style, bool ClosedWarning>
+std::string getFormattedPrices(const std::vector<std::string> &symbols, const std::vector<std::string> &names,
+                               const std::vector<std::string> &descriptions, bool *marketOpen, const PriceProgress &progress,
+                               size_t *unavailable)
+{
+    if (marketOpen)
+    {
+        *marketOpen = false;
+    }
+    if (unavailable)
     {
-        addNames = true;
+        *unavailable = 0;
     }
-    if ((!descriptions.empty()) && (descriptions.size() == symbols.size()))
+
+    // Check if data is available
+    if (symbols.empty())
     {
-        addDescription = true;
+        return "No data available.";
     }
 
-    std::ostringstream formattedString;
+    // Check if there are names and descriptions available
+    bool addNames = (!names.empty()) && (names.size() == symbols.size());
+    bool addDescription = (!descriptions.empty()) && (descriptions.size() == symbols.size());
+
+    TextBuffer &formattedString = formatBuffer();
 
-    for (int i = 0; i < symbols.size(); i++)
+    for (size_t start = 0; start < symbols.size(); start += PRICE_BATCH_SIZE)
     {
-        // First fetch price data
-        Metrics data = fetchMetrics(symbols[i]);
+        // First fetch the price data of the batch
+        size_t end = std::min(start + PRICE_BATCH_SIZE, symbols.size());
+        std::vector<Metrics> batch = resolveMetrics(std::vector<std::string>(symbols.begin() + start, symbols.begin() + end));
 
-        // Now create string
-        if (!markdown)
+        for (size_t i = start; i < end; i++)
         {
-            if (addNames) // Display name
+            const Metrics &data = batch[i - start];
+            if (marketOpen && data.marketState == "REGULAR")
             {
-                formattedString << names[i] << std::endl;
+                *marketOpen = true;
             }
-            else // Otherwise just add the symbol
+            if (unavailable && data.symbol == "-") // The quote could not be fetched
             {
-                formattedString << symbols[i] << std::endl;
+                (*unavailable)++;
             }
+
+            // Now create string
+            formattedString.append(Style::heading).append(addNames ? names[i] : symbols[i]).append('\n'); // Display name, otherwise just add the symbol
             if (addDescription) // Add description if available
             {
-                formattedString << descriptions[i] << std::endl;
-            }
-            formattedString << std::fixed << std::setprecision(2);
-            formattedString << "- Latest price: " << data.latestPrice << " " << data.currency;
-            if (data.latestChange >= 0)
-            {
-                formattedString << " (+" << data.latestChange << "%)";
-            }
-            else
-            {
-                formattedString << " (" << data.latestChange << "%)";
-            }
-            if (closedWarning == true && data.marketState != "REGULAR") // Add note if market is not open
-            {
-                formattedString << " *Market is currently closed*" << std::endl;
-            }
-            else
-            {
-                formattedString << "\n"; // closedWarning adds new line, so in case of no warning, add close line here
+                formattedString.append(descriptions[i]).append('\n');
             }
+            formattedString.append("- Latest price: ");
+            appendQuote<Style>(formattedString, data);
+            appendClosedWarning<ClosedWarning>(formattedString, data);
         }
-        else
-        {
-            if (addNames) // Display name
-            {
-                formattedString << "### " << names[i] << std::endl;
-            }
-            else // Otherwise just add the symbol
-            {
-                formattedString << "### " << symbols[i] << std::endl;
-            }
-            if (addDescription) // Add description if available
-            {
-                formattedString << descriptions[i] << std::endl;
-            }
-            formattedString << std::fixed << std::setprecision(2);
-            formattedString << "- Latest price: `" << data.latestPrice << " " << data.currency;
-            if (data.latestChange >= 0)
-            {
-                formattedString << " (+" << data.latestChange << "%)`:chart_with_upwards_trend:";
-            }
-            else
-            {
-                formattedString << " (" << data.latestChange << "%)`:chart_with_downwards_trend:";
-            }
 
-            if (closedWarning == true && data.marketState != "REGULAR") // Add note if market is not open
-            {
-                formattedString << " *Market is currently closed*" << std::endl;
-            }
-            else
-            {
-                formattedString << "\n"; // closedWarning adds new line, so in case of no warning, add close line here
-            }
+        // Report the symbols resolved so far (the complete text is returned)
+        if (progress && end < symbols.size())
+        {
+            progress(formattedString.str());
         }
     }
 
     return formattedString.str();
 }
 
-std::string getFormattedJSON(const std::string &pathToJson, const std::string &key, bool markdown, bool description, bool closedWarning)
+template std::string getFormattedPrices<Markdown, false>(const std::vector<std::string> &, const std::vector<std::string> &, const std::vector<std::string> &, bool *, const PriceProgress &, size_t *);
+template std::string getFormattedPrices<Markdown, true>(const std::vector<std::string> &, const std::vector<std::string> &, const std::vector<std::string> &, bool *, const PriceProgress &, size_t *);
+template std::string getFormattedPrices<PlainText, false>(const std::vector<std::string> &, const std::vector<std::string> &, const std::vector<std::string> &, bool *, const PriceProgress &, size_t *);
+template std::string getFormattedPrices<PlainText, true>(const std::vector<std::string> &, const std::vector<std::string> &, const std::vector<std::string> &, bool *, const PriceProgress &, size_t *);
+
+std::string loadJSONSymbols(const std::string &pathToJson, const std::string &key, std::vector<std::string> &symbols,
+                            std::vector<std::string> &names, std::vector<std::string> &descriptions)
 {
     // Load JSON data from a file
     std::ifstream file(pathToJson);
@@ -481,10 +820,6 @@ std::string getFormattedJSON(const std::string &pathToJson, const std::string &k
 
     const rapidjson::Value &data = dataIt->value;
 
-    std::vector<std::string> symbols;
-    std::vector<std::string> names;
-    std::vector<std::string> descriptions;
-
     // Put data in vectors
     for (rapidjson::SizeType i = 0; i < data.Size(); ++i)
     {
@@ -493,17 +828,42 @@ std::string getFormattedJSON(const std::string &pathToJson, const std::string &k
         {
             symbols.push_back(jsonData["symbol"].GetString());
             names.push_back(jsonData["name"].GetString());
-            if (description && jsonData.HasMember("description"))
+            if (jsonData.HasMember("description"))
             {
                 descriptions.push_back(jsonData["description"].GetString());
             }
         }
     }
 
-    return getFormattedPrices(symbols, names, descriptions, markdown, closedWarning);
+    return "";
+}
+
+std::string getFormattedJSON(const std::string &pathToJson, const std::string &key, bool markdown, bool description, bool closedWarning, bool *marketOpen)
+{
+    std::vector<std::string> symbols;
+    std::vector<std::string> names;
+    std::vector<std::string> descriptions;
+    std::string error = loadJSONSymbols(pathToJson, key, symbols, names, descriptions);
+    if (!error.empty())
+    {
+        return error;
+    }
+
+    if (!description)
+    {
+        descriptions.clear();
+    }
+
+    return getFormattedPrices(symbols, names, descriptions, markdown, closedWarning, marketOpen);
 }
 
 std::string getFormattedGainsLosses(const std::string &symbol, const std::string &duration, bool markdown)
+{
+    return markdown ? getFormattedGainsLosses<Markdown>(symbol, duration) : getFormattedGainsLosses<PlainText>(symbol, duration);
+}
+
+template <class Style>
+std::string getFormattedGainsLosses(const std::string &symbol, const std::string &duration)
 {
     // Fetch data
     Metrics data = fetchMetrics(symbol);
@@ -514,6 +874,15 @@ std::string getFormattedGainsLosses(const std::string &symbol, const std::string
         return "";
     }
 
+    return formatGainsLosses<Style>(ohlcData, data.currency);
+}
+
+template std::string getFormattedGainsLosses<Markdown>(const std::string &symbol, const std::string &duration);
+template std::string getFormattedGainsLosses<PlainText>(const std::string &symbol, const std::string &duration);
+
+template <class Style>
+std::string formatGainsLosses(const std::vector<std::vector<std::string>> &ohlcData, const std::string &currency)
+{
     // Vector to store percentage changes with corresponding dates
     std::vector<GainLoss> changes;
 
@@ -546,59 +915,36 @@ std::string getFormattedGainsLosses(const std::string &symbol, const std::string
     });
 
     // Format the results
-    std::ostringstream result;
+    TextBuffer &result = formatBuffer();
 
-    if (markdown)
-    {
-        result << "### Top 5 Gains :chart_with_upwards_trend:\n";
-    }
-    else
-    {
-        result << "Top 5 Gains:\n";
-    }
-    for (size_t i = 0; i < topGains.size(); ++i)
+    // Appends one numbered line per day
+    auto appendDays = [&](const std::vector<GainLoss> &days)
     {
-        if (markdown)
-        {
-            result << i + 1 << ". " << topGains[i].date << ": `" 
-                << std::fixed << std::setprecision(2) << topGains[i].percentageChange 
-                << "% (open: " << topGains[i].openPrice << " " << data.currency 
-                << ", close: " << topGains[i].closePrice << " " << data.currency << ")`\n";
-        }
-        else
+        for (size_t i = 0; i < days.size(); ++i)
         {
-            result << i + 1 << ". " << topGains[i].date << ": " 
-                << std::fixed << std::setprecision(2) << topGains[i].percentageChange 
-                << "% (open: " << topGains[i].openPrice << " " << data.currency 
-                << ", close: " << topGains[i].closePrice << " " << data.currency << ")\n";
+            result.appendInteger(i + 1).append(". ").append(days[i].date).append(": ").append(Style::code)
+                  .appendFixed(days[i].percentageChange).append("% (open: ").appendGrouped(days[i].openPrice).append(' ').append(currency)
+                  .append(", close: ").appendGrouped(days[i].closePrice).append(' ').append(currency).append(')').append(Style::code).append('\n');
         }
-    }
+    };
 
-    if (markdown)
+    if constexpr (Style::markdown)
     {
-        result << "\n### Top 5 Losses :chart_with_downwards_trend:\n";
+        result.append("### Top 5 Gains :chart_with_upwards_trend:\n");
+        appendDays(topGains);
+        result.append("\n### Top 5 Losses :chart_with_downwards_trend:\n");
+        appendDays(topLosses);
     }
     else
     {
-        result << "\nTop 5 Losses:\n";
-    }
-    for (size_t i = 0; i < topLosses.size(); ++i)
-    {
-        if (markdown)
-        {
-            result << i + 1 << ". " << topLosses[i].date << ": `" 
-                << std::fixed << std::setprecision(2) << topLosses[i].percentageChange 
-                << "% (open: " << topLosses[i].openPrice << " " << data.currency 
-                << ", close: " << topLosses[i].closePrice << " " << data.currency << ")`\n";
-        }
-        else
-        {
-            result << i + 1 << ". " << topLosses[i].date << ": " 
-                << std::fixed << std::setprecision(2) << topLosses[i].percentageChange 
-                << "% (open: " << topLosses[i].openPrice << " " << data.currency 
-                << ", close: " << topLosses[i].closePrice << " " << data.currency << ")\n";
-        }
+        result.append("Top 5 Gains:\n");
+        appendDays(topGains);
+        result.append("\nTop 5 Losses:\n");
+        appendDays(topLosses);
     }
 
     return result.str();
-}
\ No newline at end of file
+}
+
+template std::string formatGainsLosses<Markdown>(const std::vector<std::vector<std::string>> &ohlcData, const std::string &currency);
+template std::string formatGainsLosses<PlainText>(const std::vector<std::vector<std::string>> &ohlcData, const std::string &currency);
\ No newline at end of file
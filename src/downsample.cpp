@@ -0,0 +1,99 @@
+#include "downsample.h"
+#include <algorithm>
+#include <cmath>
+
+void downsampleLTTB(const std::vector<double> &values, std::size_t maxPoints, std::vector<double> &xs, std::vector<double> &ys)
+{
+    xs.clear();
+    ys.clear();
+    std::size_t count = values.size();
+
+    // Nothing to reduce
+    if (maxPoints >= count || maxPoints < 3)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            xs.push_back(static_cast<double>(i));
+            ys.push_back(values[i]);
+        }
+        return;
+    }
+
+    xs.reserve(maxPoints);
+    ys.reserve(maxPoints);
+
+    // The first and last point are always kept, the others are divided over maxPoints - 2 buckets
+    double bucketSize = static_cast<double>(count - 2) / (maxPoints - 2);
+    std::size_t previous = 0;
+    xs.push_back(0);
+    ys.push_back(values[0]);
+
+    for (std::size_t bucket = 0; bucket < maxPoints - 2; bucket++)
+    {
+        // Average of the next bucket (the last point for the last bucket)
+        std::size_t nextStart = static_cast<std::size_t>(std::floor((bucket + 1) * bucketSize)) + 1;
+        std::size_t nextEnd = std::min(static_cast<std::size_t>(std::floor((bucket + 2) * bucketSize)) + 1, count);
+        double averageX = 0, averageY = 0;
+        for (std::size_t i = nextStart; i < nextEnd; i++)
+        {
+            averageX += static_cast<double>(i);
+            averageY += values[i];
+        }
+        std::size_t nextCount = nextEnd - nextStart;
+        averageX /= nextCount;
+        averageY /= nextCount;
+
+        // Point of the current bucket that forms the largest triangle with the previous point and the average
+        std::size_t start = static_cast<std::size_t>(std::floor(bucket * bucketSize)) + 1;
+        std::size_t end = static_cast<std::size_t>(std::floor((bucket + 1) * bucketSize)) + 1;
+        double previousX = static_cast<double>(previous), previousY = values[previous];
+        double largestArea = -1;
+        std::size_t selected = start;
+        for (std::size_t i = start; i < end; i++)
+        {
+            double area = std::abs((previousX - averageX) * (values[i] - previousY) -
+                                   (previousX - static_cast<double>(i)) * (averageY - previousY));
+            if (area > largestArea)
+            {
+                largestArea = area;
+                selected = i;
+            }
+        }
+
+        xs.push_back(static_cast<double>(selected));
+        ys.push_back(values[selected]);
+        previous = selected;
+    }
+
+    xs.push_back(static_cast<double>(count - 1));
+    ys.push_back(values[count - 1]);
+}
+
+ChartData downsampleCandles(const ChartData &data, std::size_t maxCandles)
+{
+    std::size_t count = data.dates.size();
+    if (maxCandles == 0 || count <= maxCandles)
+    {
+        return data;
+    }
+
+    ChartData merged;
+    merged.currency = data.currency;
+    std::size_t bucketSize = (count + maxCandles - 1) / maxCandles; // Whole days per candle
+    for (std::size_t start = 0; start < count; start += bucketSize)
+    {
+        std::size_t end = std::min(start + bucketSize, count);
+        merged.dates.push_back(data.dates[start]);
+        merged.open.push_back(data.open[start]);
+        merged.close.push_back(data.close[end - 1]);
+        merged.high.push_back(*std::max_element(data.high.begin() + start, data.high.begin() + end));
+        merged.low.push_back(*std::min_element(data.low.begin() + start, data.low.begin() + end));
+        double volume = 0;
+        for (std::size_t i = start; i < end; i++)
+        {
+            volume += data.volume[i];
+        }
+        merged.volume.push_back(volume);
+    }
+    return merged;
+}
@@ -0,0 +1,353 @@
+#include "font.h"
+
+// Glyphs of DejaVu Sans rendered at 13 pixels (ASCII 32 to 126), see font.h for the license.
+// Format: left bearing, top bearing (above baseline), width, height, advance, offset into FONT_ALPHA
+static const Glyph FONT_GLYPHS[95] = {
+    {0, 0, 0, 0, 4, 0}, // ' '
+    {1, 9, 3, 9, 5, 0}, // '!'
+    {1, 9, 4, 4, 6, 27}, // '"'
+    {1, 9, 9, 9, 11, 43}, // '#'
+    {1, 10, 7, 12, 8, 124}, // '$'
+    {0, 9, 12, 9, 12, 208}, // '%'
+    {0, 9, 10, 9, 10, 316}, // '&'
+    {1, 9, 2, 4, 4, 406}, // '\''
+    {1, 10, 4, 11, 5, 414}, // '('
+    {1, 10, 3, 11, 5, 458}, // ')'
+    {0, 9, 7, 6, 7, 491}, // '*'
+    {1, 8, 9, 8, 11, 533}, // '+'
+    {1, 2, 2, 3, 4, 605}, // ','
+    {0, 4, 5, 1, 5, 611}, // '-'
+    {1, 2, 2, 2, 4, 616}, // '.'
+    {0, 9, 5, 11, 4, 620}, // '/'
+    {0, 9, 8, 9, 8, 675}, // '0'
+    {1, 9, 7, 9, 8, 747}, // '1'
+    {0, 9, 7, 9, 8, 810}, // '2'
+    {0, 9, 8, 9, 8, 873}, // '3'
+    {0, 9, 8, 9, 8, 945}, // '4'
+    {1, 9, 7, 9, 8, 1017}, // '5'
+    {0, 9, 8, 9, 8, 1080}, // '6'
+    {1, 9, 7, 9, 8, 1152}, // '7'
+    {0, 9, 8, 9, 8, 1215}, // '8'
+    {0, 9, 8, 9, 8, 1287}, // '9'
+    {1, 7, 2, 7, 4, 1359}, // ':'
+    {1, 7, 2, 8, 4, 1373}, // ';'
+    {1, 8, 9, 8, 11, 1389}, // '<'
+    {1, 6, 9, 5, 11, 1461}, // '='
+    {1, 8, 9, 8, 11, 1506}, // '>'
+    {0, 9, 6, 9, 7, 1578}, // '?'
+    {0, 9, 13, 11, 13, 1632}, // '@'
+    {0, 9, 9, 9, 9, 1775}, // 'A'
+    {1, 9, 7, 9, 9, 1856}, // 'B'
+    {0, 9, 9, 9, 9, 1919}, // 'C'
+    {1, 9, 9, 9, 10, 2000}, // 'D'
+    {1, 9, 7, 9, 8, 2081}, // 'E'
+    {1, 9, 6, 9, 7, 2144}, // 'F'
+    {0, 9, 9, 9, 10, 2198}, // 'G'
+    {1, 9, 8, 9, 10, 2279}, // 'H'
+    {1, 9, 2, 9, 4, 2351}, // 'I'
+    {-1, 9, 4, 12, 4, 2369}, // 'J'
+    {1, 9, 8, 9, 9, 2417}, // 'K'
+    {1, 9, 7, 9, 7, 2489}, // 'L'
+    {1, 9, 9, 9, 11, 2552}, // 'M'
+    {1, 9, 8, 9, 10, 2633}, // 'N'
+    {0, 9, 10, 9, 10, 2705}, // 'O'
+    {1, 9, 7, 9, 8, 2795}, // 'P'
+    {0, 9, 10, 11, 10, 2858}, // 'Q'
+    {1, 9, 8, 9, 9, 2968}, // 'R'
+    {0, 9, 8, 9, 8, 3040}, // 'S'
+    {-1, 9, 9, 9, 8, 3112}, // 'T'
+    {1, 9, 8, 9, 10, 3193}, // 'U'
+    {0, 9, 9, 9, 9, 3265}, // 'V'
+    {0, 9, 13, 9, 13, 3346}, // 'W'
+    {0, 9, 9, 9, 9, 3463}, // 'X'
+    {-1, 9, 9, 9, 8, 3544}, // 'Y'
+    {0, 9, 9, 9, 9, 3625}, // 'Z'
+    {1, 10, 3, 11, 5, 3706}, // '['
+    {0, 9, 5, 11, 4, 3739}, // '\\'
+    {1, 10, 3, 11, 5, 3794}, // ']'
+    {1, 10, 9, 4, 11, 3827}, // '^'
+    {-1, -2, 8, 1, 7, 3863}, // '_'
+    {1, 11, 4, 3, 7, 3871}, // '`'
+    {0, 7, 7, 7, 8, 3883}, // 'a'
+    {1, 10, 7, 10, 8, 3932}, // 'b'
+    {0, 7, 7, 7, 7, 4002}, // 'c'
+    {0, 10, 8, 10, 8, 4051}, // 'd'
+    {0, 7, 8, 7, 8, 4131}, // 'e'
+    {0, 10, 5, 10, 5, 4187}, // 'f'
+    {0, 7, 8, 10, 8, 4237}, // 'g'
+    {1, 10, 7, 10, 8, 4317}, // 'h'
+    {1, 10, 2, 10, 4, 4387}, // 'i'
+    {-1, 10, 4, 13, 4, 4407}, // 'j'
+    {1, 10, 7, 10, 8, 4459}, // 'k'
+    {1, 10, 2, 10, 4, 4529}, // 'l'
+    {1, 7, 11, 7, 13, 4549}, // 'm'
+    {1, 7, 7, 7, 8, 4626}, // 'n'
+    {0, 7, 8, 7, 8, 4675}, // 'o'
+    {1, 7, 7, 10, 8, 4731}, // 'p'
+    {0, 7, 8, 10, 8, 4801}, // 'q'
+    {1, 8, 5, 8, 5, 4881}, // 'r'
+    {0, 7, 7, 7, 7, 4921}, // 's'
+    {0, 9, 5, 9, 5, 4970}, // 't'
+    {1, 7, 7, 7, 8, 5015}, // 'u'
+    {0, 7, 8, 7, 8, 5064}, // 'v'
+    {0, 7, 11, 7, 11, 5120}, // 'w'
+    {0, 7, 8, 7, 8, 5197}, // 'x'
+    {0, 7, 8, 10, 8, 5253}, // 'y'
+    {0, 7, 7, 7, 7, 5333}, // 'z'
+    {1, 10, 6, 12, 8, 5382}, // '{'
+    {1, 10, 2, 13, 4, 5454}, // '|'
+    {1, 10, 6, 12, 8, 5480}, // '}'
+    {1, 6, 9, 4, 11, 5552}, // '~'
+};
+
+// 8-bit coverage of all glyphs, row by row
+static const unsigned char FONT_ALPHA[5588] = {
+    8, 255, 64, 8, 255, 64, 8, 255, 64, 8, 255, 64, 2, 254, 56, 0, 242, 41, 0, 40, 5, 4, 140, 35,
+    8, 255, 64, 192, 84, 88, 188, 192, 84, 88, 188, 192, 84, 88, 188, 75, 32, 34, 73, 0, 0, 0, 112, 147,
+    0, 144, 116, 0, 0, 0, 0, 167, 92, 0, 199, 62, 0, 0, 0, 0, 223, 37, 6, 245, 11, 0, 63, 240,
+    241, 254, 240, 243, 252, 240, 213, 0, 0, 95, 168, 0, 126, 136, 0, 0, 0, 0, 160, 103, 0, 190, 71, 0,
+    0, 232, 232, 253, 235, 233, 253, 233, 232, 39, 0, 45, 215, 0, 77, 186, 0, 0, 0, 0, 127, 133, 0, 159,
+    102, 0, 0, 0, 0, 0, 60, 100, 0, 0, 0, 0, 0, 60, 100, 0, 0, 0, 33, 172, 220, 229, 204, 102,
+    0, 191, 138, 62, 100, 21, 53, 0, 219, 94, 60, 100, 0, 0, 0, 95, 241, 203, 170, 60, 0, 0, 0, 19,
+    118, 193, 226, 169, 0, 0, 0, 60, 100, 24, 255, 31, 101, 15, 60, 100, 79, 247, 13, 141, 220, 232, 240, 212,
+    78, 0, 0, 0, 64, 100, 0, 0, 0, 0, 0, 61, 100, 0, 0, 0, 0, 115, 209, 208, 75, 0, 0, 0,
+    176, 83, 0, 0, 30, 230, 11, 37, 232, 0, 0, 89, 170, 0, 0, 0, 62, 194, 0, 0, 243, 14, 22, 215,
+    22, 0, 0, 0, 23, 230, 18, 51, 223, 0, 171, 88, 0, 0, 0, 0, 0, 87, 195, 190, 56, 84, 175, 14,
+    160, 195, 144, 5, 0, 0, 0, 0, 19, 215, 24, 135, 138, 0, 168, 105, 0, 0, 0, 0, 166, 93, 0, 182,
+    74, 0, 103, 154, 0, 0, 0, 79, 180, 0, 0, 146, 121, 0, 151, 118, 0, 0, 17, 215, 27, 0, 0, 24,
+    189, 199, 178, 12, 0, 0, 75, 213, 246, 222, 99, 0, 0, 0, 0, 5, 244, 109, 3, 33, 59, 0, 0, 0,
+    0, 8, 247, 64, 0, 0, 0, 0, 0, 0, 0, 1, 184, 223, 31, 0, 0, 0, 0, 0, 0, 142, 190, 117,
+    226, 40, 0, 2, 219, 41, 20, 252, 44, 0, 106, 233, 49, 51, 235, 2, 27, 255, 33, 0, 0, 102, 239, 200,
+    118, 0, 0, 192, 173, 12, 0, 16, 200, 255, 68, 0, 0, 18, 149, 216, 208, 205, 119, 105, 243, 67, 192, 84,
+    192, 84, 192, 84, 75, 32, 0, 71, 195, 0, 1, 214, 66, 0, 71, 220, 1, 0, 151, 152, 0, 0, 201, 110,
+    0, 0, 218, 96, 0, 0, 201, 110, 0, 0, 152, 152, 0, 0, 72, 219, 0, 0, 1, 215, 64, 0, 0, 72,
+    194, 0, 177, 91, 0, 47, 228, 6, 0, 205, 90, 0, 136, 170, 0, 91, 220, 0, 77, 238, 0, 91, 220, 0,
+    135, 171, 0, 204, 91, 46, 229, 6, 175, 92, 0, 0, 0, 28, 156, 0, 0, 0, 87, 128, 38, 156, 56, 166,
+    3, 0, 62, 185, 233, 127, 14, 0, 18, 136, 169, 207, 173, 69, 0, 67, 55, 28, 156, 9, 109, 3, 0, 0,
+    19, 109, 0, 0, 0, 0, 0, 0, 19, 208, 0, 0, 0, 0, 0, 0, 0, 24, 252, 0, 0, 0, 0, 0,
+    0, 0, 24, 252, 0, 0, 0, 0, 147, 236, 236, 237, 255, 236, 236, 236, 121, 17, 28, 28, 49, 252, 28, 28,
+    28, 14, 0, 0, 0, 24, 252, 0, 0, 0, 0, 0, 0, 0, 24, 252, 0, 0, 0, 0, 0, 0, 0, 24,
+    252, 0, 0, 0, 0, 120, 220, 151, 158, 214, 30, 92, 255, 255, 255, 16, 85, 102, 156, 188, 0, 0, 0, 220,
+    55, 0, 0, 45, 229, 1, 0, 0, 125, 150, 0, 0, 0, 206, 70, 0, 0, 30, 239, 5, 0, 0, 110, 165,
+    0, 0, 0, 191, 85, 0, 0, 19, 244, 12, 0, 0, 96, 180, 0, 0, 0, 176, 100, 0, 0, 0, 118, 20,
+    0, 0, 0, 0, 3, 139, 235, 245, 175, 23, 0, 0, 124, 226, 44, 22, 181, 191, 0, 0, 228, 109, 0, 0,
+    41, 255, 39, 19, 255, 56, 0, 0, 0, 245, 86, 33, 255, 41, 0, 0, 0, 229, 100, 19, 255, 56, 0, 0,
+    0, 245, 86, 0, 228, 107, 0, 0, 39, 255, 39, 0, 124, 222, 39, 17, 177, 192, 0, 0, 3, 140, 236, 245,
+    176, 23, 0, 91, 197, 244, 252, 0, 0, 0, 72, 87, 107, 252, 0, 0, 0, 0, 0, 76, 252, 0, 0, 0,
+    0, 0, 76, 252, 0, 0, 0, 0, 0, 76, 252, 0, 0, 0, 0, 0, 76, 252, 0, 0, 0, 0, 0, 76,
+    252, 0, 0, 0, 3, 8, 81, 252, 8, 8, 0, 100, 255, 255, 255, 255, 255, 20, 0, 136, 211, 246, 228, 150,
+    14, 0, 158, 67, 24, 53, 216, 161, 0, 0, 0, 0, 0, 111, 221, 0, 0, 0, 0, 0, 172, 172, 0, 0,
+    0, 0, 106, 234, 32, 0, 0, 0, 111, 229, 43, 0, 0, 0, 126, 226, 37, 0, 0, 0, 140, 225, 39, 8,
+    8, 7, 12, 255, 255, 255, 255, 255, 248, 0, 125, 218, 247, 236, 175, 34, 0, 0, 56, 39, 17, 32, 159, 206,
+    0, 0, 0, 0, 0, 3, 130, 245, 0, 0, 0, 87, 232, 247, 252, 116, 0, 0, 0, 9, 25, 56, 150, 67,
+    0, 0, 0, 0, 0, 0, 37, 245, 19, 0, 0, 0, 0, 0, 38, 255, 44, 2, 123, 41, 15, 48, 191, 223,
+    4, 2, 175, 231, 250, 229, 165, 35, 0, 0, 0, 0, 1, 191, 255, 48, 0, 0, 0, 0, 108, 187, 255, 48,
+    0, 0, 0, 34, 222, 43, 255, 48, 0, 0, 1, 191, 88, 24, 255, 48, 0, 0, 108, 178, 0, 24, 255, 48,
+    0, 33, 229, 27, 0, 24, 255, 48, 0, 92, 249, 236, 236, 237, 255, 239, 129, 10, 28, 28, 28, 49, 255, 70,
+    15, 0, 0, 0, 0, 24, 255, 48, 0, 152, 255, 255, 255, 255, 112, 0, 152, 151, 8, 8, 8, 3, 0, 152,
+    148, 0, 0, 0, 0, 0, 152, 232, 228, 206, 129, 10, 0, 67, 59, 35, 76, 217, 169, 0, 0, 0, 0, 0,
+    67, 253, 11, 0, 0, 0, 0, 61, 254, 14, 102, 33, 15, 56, 207, 182, 0, 186, 235, 249, 224, 145, 17, 0,
+    0, 0, 62, 196, 247, 238, 159, 0, 0, 58, 245, 113, 30, 30, 70, 0, 0, 191, 148, 0, 0, 0, 0, 0,
+    5, 251, 140, 210, 241, 198, 60, 0, 20, 255, 228, 49, 9, 122, 242, 27, 9, 254, 128, 0, 0, 1, 235, 94,
+    0, 215, 127, 0, 0, 0, 236, 92, 0, 109, 228, 45, 6, 119, 240, 25, 0, 0, 124, 230, 243, 197, 57, 0,
+    240, 255, 255, 255, 255, 255, 28, 7, 8, 8, 8, 150, 193, 0, 0, 0, 0, 9, 239, 90, 0, 0, 0, 0,
+    98, 235, 7, 0, 0, 0, 0, 202, 138, 0, 0, 0, 0, 50, 254, 36, 0, 0, 0, 0, 155, 187, 0, 0,
+    0, 0, 14, 244, 83, 0, 0, 0, 0, 108, 231, 4, 0, 0, 0, 0, 26, 171, 236, 242, 193, 52, 0, 0,
+    178, 194, 26, 11, 144, 233, 3, 0, 214, 107, 0, 0, 40, 255, 28, 0, 97, 190, 25, 11, 144, 197, 1, 0,
+    36, 192, 255, 255, 224, 42, 0, 2, 224, 164, 20, 9, 110, 239, 26, 20, 255, 56, 0, 0, 0, 245, 83, 0,
+    216, 161, 16, 6, 106, 250, 36, 0, 39, 179, 237, 243, 205, 79, 0, 0, 25, 167, 235, 241, 162, 14, 0, 0,
+    197, 179, 20, 23, 187, 173, 0, 26, 255, 48, 0, 0, 57, 254, 26, 27, 255, 47, 0, 0, 57, 255, 74, 0,
+    203, 176, 17, 19, 184, 255, 88, 0, 30, 172, 231, 225, 111, 253, 68, 0, 0, 0, 0, 0, 78, 245, 14, 0,
+    51, 34, 17, 73, 226, 123, 0, 0, 106, 232, 250, 218, 109, 0, 0, 67, 123, 120, 220, 0, 0, 0, 0, 0,
+    0, 65, 120, 120, 220, 120, 220, 67, 123, 0, 0, 0, 0, 0, 0, 120, 220, 151, 158, 214, 30, 0, 0, 0,
+    0, 0, 0, 0, 2, 22, 0, 0, 0, 0, 0, 54, 143, 230, 122, 0, 0, 41, 131, 220, 224, 138, 50, 0,
+    84, 208, 230, 146, 58, 1, 0, 0, 0, 112, 242, 188, 98, 17, 0, 0, 0, 0, 0, 9, 85, 174, 242, 181,
+    94, 15, 0, 0, 0, 0, 0, 15, 96, 185, 244, 102, 0, 0, 0, 0, 0, 0, 0, 22, 44, 145, 232, 232,
+    232, 232, 232, 232, 232, 119, 15, 24, 24, 24, 24, 24, 24, 24, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    150, 240, 240, 240, 240, 240, 240, 240, 123, 17, 28, 28, 28, 28, 28, 28, 28, 14, 25, 0, 0, 0, 0, 0,
+    0, 0, 0, 150, 222, 133, 44, 0, 0, 0, 0, 0, 1, 59, 147, 232, 210, 121, 32, 0, 0, 0, 0, 0,
+    3, 67, 155, 236, 198, 67, 0, 0, 0, 0, 24, 108, 200, 236, 90, 0, 21, 103, 190, 240, 164, 75, 5, 0,
+    126, 244, 175, 86, 9, 0, 0, 0, 0, 50, 15, 0, 0, 0, 0, 0, 0, 0, 5, 141, 223, 246, 203, 54,
+    12, 131, 34, 14, 160, 219, 0, 0, 0, 0, 109, 225, 0, 0, 0, 62, 238, 79, 0, 0, 42, 241, 74, 0,
+    0, 0, 113, 194, 0, 0, 0, 0, 71, 108, 0, 0, 0, 0, 72, 107, 0, 0, 0, 0, 132, 196, 0, 0,
+    0, 0, 0, 26, 134, 205, 225, 217, 163, 59, 0, 0, 0, 0, 0, 81, 218, 113, 27, 1, 6, 69, 194, 142,
+    1, 0, 0, 52, 216, 26, 0, 0, 0, 0, 0, 3, 172, 102, 0, 0, 186, 68, 0, 60, 200, 217, 151, 179,
+    48, 22, 221, 0, 9, 224, 0, 5, 232, 72, 0, 66, 251, 52, 0, 223, 13, 30, 199, 0, 33, 226, 0, 0,
+    0, 215, 52, 9, 233, 4, 10, 222, 0, 5, 231, 70, 0, 63, 250, 66, 157, 133, 0, 0, 191, 60, 0, 60,
+    201, 219, 154, 171, 194, 95, 1, 0, 0, 58, 212, 21, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 88,
+    218, 97, 17, 0, 16, 112, 221, 12, 0, 0, 0, 0, 0, 33, 144, 210, 224, 214, 149, 37, 0, 0, 0, 0,
+    0, 0, 124, 255, 94, 0, 0, 0, 0, 0, 2, 223, 237, 197, 0, 0, 0, 0, 0, 73, 251, 75, 255, 44,
+    0, 0, 0, 0, 176, 178, 0, 208, 146, 0, 0, 0, 26, 251, 80, 0, 110, 239, 9, 0, 0, 125, 233, 4,
+    0, 18, 248, 96, 0, 2, 225, 249, 232, 232, 232, 251, 198, 0, 74, 253, 51, 24, 24, 24, 70, 255, 45, 177,
+    173, 0, 0, 0, 0, 0, 198, 148, 184, 255, 255, 252, 224, 128, 1, 184, 145, 4, 8, 63, 242, 97, 184, 144,
+    0, 0, 0, 187, 145, 184, 144, 0, 0, 36, 236, 92, 184, 245, 232, 236, 254, 164, 1, 184, 154, 24, 25, 55,
+    201, 150, 184, 144, 0, 0, 0, 104, 242, 184, 145, 4, 5, 36, 193, 200, 184, 255, 255, 254, 234, 172, 32, 0,
+    0, 54, 177, 236, 247, 215, 135, 20, 0, 72, 248, 144, 42, 11, 40, 136, 90, 1, 223, 152, 0, 0, 0, 0,
+    0, 1, 42, 255, 56, 0, 0, 0, 0, 0, 0, 63, 255, 29, 0, 0, 0, 0, 0, 0, 42, 255, 56, 0,
+    0, 0, 0, 0, 0, 1, 223, 150, 0, 0, 0, 0, 0, 1, 0, 72, 248, 140, 41, 10, 40, 136, 90, 0,
+    0, 54, 178, 237, 247, 216, 136, 20, 184, 255, 255, 247, 222, 164, 52, 0, 0, 184, 145, 4, 10, 43, 143, 252,
+    81, 0, 184, 144, 0, 0, 0, 0, 158, 228, 1, 184, 144, 0, 0, 0, 0, 66, 255, 40, 184, 144, 0, 0,
+    0, 0, 37, 255, 59, 184, 144, 0, 0, 0, 0, 66, 255, 40, 184, 144, 0, 0, 0, 0, 157, 228, 1, 184,
+    145, 4, 9, 42, 139, 252, 83, 0, 184, 255, 255, 248, 223, 165, 54, 0, 0, 184, 255, 255, 255, 255, 255, 68,
+    184, 147, 8, 8, 8, 8, 2, 184, 144, 0, 0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 247, 236,
+    236, 236, 236, 18, 184, 156, 28, 28, 28, 28, 2, 184, 144, 0, 0, 0, 0, 0, 184, 147, 8, 8, 8, 8,
+    3, 184, 255, 255, 255, 255, 255, 96, 184, 255, 255, 255, 255, 184, 184, 147, 8, 8, 8, 5, 184, 144, 0, 0,
+    0, 0, 184, 144, 0, 0, 0, 0, 184, 247, 236, 236, 236, 73, 184, 156, 28, 28, 28, 8, 184, 144, 0, 0,
+    0, 0, 184, 144, 0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 0, 53, 175, 234, 249, 222, 167, 56, 0,
+    73, 248, 146, 44, 12, 29, 99, 159, 1, 223, 151, 0, 0, 0, 0, 0, 0, 42, 255, 56, 0, 0, 0, 0,
+    0, 0, 63, 255, 29, 0, 0, 83, 232, 232, 232, 43, 255, 56, 0, 0, 8, 24, 85, 255, 1, 224, 150, 0,
+    0, 0, 0, 68, 255, 0, 75, 249, 143, 42, 11, 27, 131, 255, 0, 0, 55, 176, 236, 251, 232, 167, 52, 184,
+    144, 0, 0, 0, 0, 200, 128, 184, 144, 0, 0, 0, 0, 200, 128, 184, 144, 0, 0, 0, 0, 200, 128, 184,
+    144, 0, 0, 0, 0, 200, 128, 184, 247, 236, 236, 236, 236, 251, 128, 184, 156, 28, 28, 28, 28, 206, 128, 184,
+    144, 0, 0, 0, 0, 200, 128, 184, 144, 0, 0, 0, 0, 200, 128, 184, 144, 0, 0, 0, 0, 200, 128, 184,
+    144, 184, 144, 184, 144, 184, 144, 184, 144, 184, 144, 184, 144, 184, 144, 184, 144, 0, 0, 184, 144, 0, 0, 184,
+    144, 0, 0, 184, 144, 0, 0, 184, 144, 0, 0, 184, 144, 0, 0, 184, 144, 0, 0, 184, 144, 0, 0, 184,
+    144, 0, 0, 184, 143, 0, 0, 201, 122, 6, 63, 251, 65, 171, 229, 128, 0, 184, 144, 0, 0, 10, 180, 207,
+    25, 184, 144, 0, 20, 201, 188, 14, 0, 184, 144, 33, 218, 165, 6, 0, 0, 184, 188, 232, 140, 1, 0, 0,
+    0, 184, 241, 242, 43, 0, 0, 0, 0, 184, 145, 144, 236, 51, 0, 0, 0, 184, 144, 0, 132, 240, 59, 0,
+    0, 184, 144, 0, 0, 120, 244, 67, 0, 184, 144, 0, 0, 0, 108, 246, 77, 184, 144, 0, 0, 0, 0, 0,
+    184, 144, 0, 0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 144, 0,
+    0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 147, 8, 8, 8, 8,
+    1, 184, 255, 255, 255, 255, 255, 44, 184, 255, 98, 0, 0, 0, 43, 255, 244, 184, 214, 199, 0, 0, 0, 144,
+    213, 244, 184, 137, 232, 44, 0, 7, 236, 113, 244, 184, 132, 136, 145, 0, 90, 191, 76, 244, 184, 132, 35, 236,
+    8, 192, 89, 76, 244, 184, 132, 0, 188, 130, 235, 7, 76, 244, 184, 132, 0, 86, 254, 141, 0, 76, 244, 184,
+    132, 0, 5, 68, 20, 0, 76, 244, 184, 132, 0, 0, 0, 0, 0, 76, 244, 184, 255, 71, 0, 0, 0, 204,
+    116, 184, 236, 210, 3, 0, 0, 204, 116, 184, 140, 224, 100, 0, 0, 204, 116, 184, 132, 90, 231, 12, 0, 204,
+    116, 184, 132, 1, 201, 130, 0, 204, 116, 184, 132, 0, 60, 245, 27, 204, 116, 184, 132, 0, 0, 173, 160, 204,
+    116, 184, 132, 0, 0, 36, 248, 237, 116, 184, 132, 0, 0, 0, 143, 255, 116, 0, 0, 59, 185, 242, 247, 205,
+    93, 0, 0, 0, 74, 248, 130, 31, 19, 95, 241, 126, 0, 1, 223, 150, 0, 0, 0, 0, 94, 251, 31, 42,
+    255, 56, 0, 0, 0, 0, 3, 249, 100, 63, 255, 28, 0, 0, 0, 0, 0, 225, 122, 42, 255, 55, 0, 0,
+    0, 0, 3, 249, 101, 1, 224, 148, 0, 0, 0, 0, 92, 252, 32, 0, 77, 249, 128, 29, 18, 93, 240, 129,
+    0, 0, 0, 62, 187, 243, 248, 206, 96, 0, 0, 184, 255, 255, 245, 207, 83, 0, 184, 145, 4, 15, 122, 251,
+    39, 184, 144, 0, 0, 3, 253, 87, 184, 144, 0, 0, 93, 254, 46, 184, 245, 232, 242, 232, 107, 0, 184, 154,
+    24, 13, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 144, 0, 0, 0, 0, 0, 184, 144, 0, 0, 0,
+    0, 0, 0, 0, 59, 185, 242, 247, 204, 91, 0, 0, 0, 74, 248, 130, 31, 19, 95, 241, 122, 0, 1, 223,
+    150, 0, 0, 0, 0, 94, 250, 28, 42, 255, 56, 0, 0, 0, 0, 3, 249, 98, 63, 255, 28, 0, 0, 0,
+    0, 0, 225, 121, 42, 255, 55, 0, 0, 0, 0, 3, 249, 99, 1, 224, 148, 0, 0, 0, 0, 92, 253, 32,
+    0, 77, 249, 128, 29, 18, 93, 240, 141, 0, 0, 0, 62, 187, 243, 255, 254, 114, 2, 0, 0, 0, 0, 0,
+    0, 16, 208, 158, 1, 0, 0, 0, 0, 0, 0, 0, 22, 127, 46, 0, 184, 255, 255, 246, 209, 88, 0, 0,
+    184, 145, 4, 14, 116, 252, 39, 0, 184, 144, 0, 0, 2, 252, 88, 0, 184, 144, 0, 0, 90, 255, 49, 0,
+    184, 245, 232, 242, 249, 102, 0, 0, 184, 154, 24, 45, 187, 171, 0, 0, 184, 144, 0, 0, 21, 240, 83, 0,
+    184, 144, 0, 0, 0, 125, 216, 3, 184, 144, 0, 0, 0, 13, 236, 100, 0, 40, 176, 235, 247, 220, 157, 0,
+    1, 222, 159, 27, 8, 42, 112, 0, 23, 255, 49, 0, 0, 0, 0, 0, 1, 212, 195, 86, 36, 0, 0, 0,
+    0, 18, 130, 203, 248, 227, 107, 0, 0, 0, 0, 0, 8, 99, 253, 73, 0, 0, 0, 0, 0, 0, 222, 122,
+    21, 141, 51, 13, 15, 104, 253, 64, 12, 152, 216, 246, 241, 202, 90, 0, 8, 255, 255, 255, 255, 255, 255, 255,
+    252, 0, 8, 8, 8, 174, 159, 8, 8, 7, 0, 0, 0, 0, 172, 156, 0, 0, 0, 0, 0, 0, 0, 172,
+    156, 0, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0, 0, 0, 0,
+    0, 0, 172, 156, 0, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0,
+    0, 224, 108, 0, 0, 0, 0, 232, 100, 224, 108, 0, 0, 0, 0, 232, 100, 224, 108, 0, 0, 0, 0, 232,
+    100, 224, 108, 0, 0, 0, 0, 232, 100, 224, 108, 0, 0, 0, 0, 232, 100, 219, 113, 0, 0, 0, 0, 238,
+    95, 186, 150, 0, 0, 0, 19, 255, 61, 89, 243, 75, 11, 28, 167, 214, 6, 0, 98, 209, 244, 230, 169, 32,
+    0, 177, 162, 0, 0, 0, 0, 0, 191, 148, 74, 246, 16, 0, 0, 0, 37, 254, 46, 2, 225, 109, 0, 0,
+    0, 139, 198, 0, 0, 125, 210, 0, 0, 6, 234, 96, 0, 0, 26, 251, 55, 0, 87, 239, 10, 0, 0, 0,
+    176, 157, 0, 189, 146, 0, 0, 0, 0, 73, 244, 49, 254, 44, 0, 0, 0, 0, 2, 224, 222, 197, 0, 0,
+    0, 0, 0, 0, 123, 255, 95, 0, 0, 0, 111, 220, 0, 0, 0, 110, 255, 69, 0, 0, 9, 248, 73, 43,
+    255, 31, 0, 0, 176, 212, 136, 0, 0, 68, 250, 12, 0, 230, 98, 0, 3, 239, 84, 203, 0, 0, 135, 194,
+    0, 0, 164, 165, 0, 54, 215, 5, 241, 17, 0, 202, 127, 0, 0, 96, 231, 0, 121, 149, 0, 183, 82, 15,
+    252, 59, 0, 0, 29, 255, 42, 187, 83, 0, 118, 149, 79, 243, 5, 0, 0, 0, 217, 117, 244, 19, 0, 52,
+    216, 146, 180, 0, 0, 0, 0, 150, 231, 207, 0, 0, 2, 239, 231, 113, 0, 0, 0, 0, 82, 255, 141, 0,
+    0, 0, 177, 255, 45, 0, 0, 6, 208, 141, 0, 0, 0, 111, 225, 15, 0, 43, 245, 66, 0, 44, 245, 63,
+    0, 0, 0, 111, 227, 24, 210, 137, 0, 0, 0, 0, 1, 185, 234, 207, 6, 0, 0, 0, 0, 0, 121, 255,
+    113, 0, 0, 0, 0, 0, 45, 245, 136, 240, 30, 0, 0, 0, 7, 210, 133, 0, 159, 192, 2, 0, 0, 142,
+    204, 5, 0, 13, 222, 116, 0, 67, 244, 39, 0, 0, 0, 60, 245, 45, 0, 173, 181, 0, 0, 0, 2, 192,
+    156, 0, 18, 228, 107, 0, 0, 119, 218, 11, 0, 0, 66, 244, 42, 49, 244, 53, 0, 0, 0, 0, 138, 208,
+    214, 121, 0, 0, 0, 0, 0, 6, 213, 200, 2, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0, 0, 0, 0,
+    0, 0, 172, 156, 0, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0, 0, 0, 0, 0, 0, 172, 156, 0, 0,
+    0, 68, 255, 255, 255, 255, 255, 255, 255, 43, 2, 8, 8, 8, 8, 17, 205, 175, 2, 0, 0, 0, 0, 1,
+    171, 204, 10, 0, 0, 0, 0, 0, 136, 227, 26, 0, 0, 0, 0, 0, 97, 243, 48, 0, 0, 0, 0, 0,
+    65, 247, 76, 0, 0, 0, 0, 0, 39, 238, 111, 0, 0, 0, 0, 0, 20, 220, 156, 8, 8, 8, 8, 8,
+    2, 107, 255, 255, 255, 255, 255, 255, 255, 84, 224, 233, 182, 224, 72, 0, 224, 72, 0, 224, 72, 0, 224, 72,
+    0, 224, 72, 0, 224, 72, 0, 224, 72, 0, 224, 72, 0, 224, 72, 0, 206, 221, 175, 216, 59, 0, 0, 0,
+    136, 140, 0, 0, 0, 55, 220, 0, 0, 0, 1, 229, 45, 0, 0, 0, 151, 125, 0, 0, 0, 70, 205, 0,
+    0, 0, 5, 239, 30, 0, 0, 0, 165, 110, 0, 0, 0, 85, 191, 0, 0, 0, 12, 244, 19, 0, 0, 0,
+    100, 37, 164, 231, 244, 0, 56, 244, 0, 56, 244, 0, 56, 244, 0, 56, 244, 0, 56, 244, 0, 56, 244, 0,
+    56, 244, 0, 56, 244, 0, 56, 244, 158, 220, 224, 0, 0, 0, 53, 128, 39, 0, 0, 0, 0, 0, 55, 240,
+    189, 230, 37, 0, 0, 0, 52, 234, 93, 0, 116, 227, 36, 0, 50, 225, 69, 0, 0, 0, 90, 220, 34, 28,
+    224, 224, 224, 224, 224, 224, 140, 91, 64, 0, 0, 39, 222, 28, 0, 0, 70, 188, 2, 0, 110, 215, 243, 227,
+    139, 5, 0, 86, 35, 1, 40, 219, 111, 0, 0, 0, 0, 0, 113, 178, 0, 75, 191, 225, 225, 236, 199, 21,
+    251, 75, 2, 0, 112, 200, 33, 253, 27, 0, 19, 212, 200, 0, 117, 218, 197, 180, 133, 200, 208, 92, 0, 0,
+    0, 0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 127, 196, 242, 206, 59, 0,
+    208, 231, 50, 3, 106, 241, 20, 208, 132, 0, 0, 0, 212, 102, 208, 99, 0, 0, 0, 180, 130, 208, 131, 0,
+    0, 0, 212, 102, 208, 230, 48, 3, 103, 242, 21, 208, 127, 196, 242, 207, 61, 0, 0, 14, 145, 223, 243, 212,
+    55, 0, 177, 189, 31, 1, 39, 34, 30, 255, 35, 0, 0, 0, 0, 62, 252, 1, 0, 0, 0, 0, 30, 255,
+    34, 0, 0, 0, 0, 0, 179, 187, 29, 1, 38, 34, 0, 15, 149, 226, 243, 211, 54, 0, 0, 0, 0, 0,
+    24, 255, 20, 0, 0, 0, 0, 0, 24, 255, 20, 0, 0, 0, 0, 0, 24, 255, 20, 0, 25, 180, 239, 218,
+    97, 255, 20, 0, 194, 165, 10, 22, 194, 255, 20, 35, 255, 23, 0, 0, 68, 255, 20, 63, 243, 0, 0, 0,
+    32, 255, 20, 35, 255, 13, 0, 0, 56, 255, 20, 0, 196, 132, 0, 3, 172, 255, 20, 0, 27, 182, 205, 188,
+    104, 255, 20, 0, 12, 145, 224, 237, 180, 31, 0, 0, 174, 180, 23, 6, 135, 206, 2, 28, 255, 29, 0, 0,
+    3, 243, 46, 61, 254, 216, 216, 216, 216, 233, 71, 30, 254, 21, 0, 0, 0, 0, 0, 0, 175, 177, 29, 0,
+    17, 86, 4, 0, 13, 139, 221, 243, 224, 161, 3, 0, 14, 182, 238, 198, 0, 111, 192, 3, 0, 0, 144, 152,
+    0, 0, 154, 240, 241, 220, 113, 0, 148, 152, 0, 0, 0, 148, 152, 0, 0, 0, 148, 152, 0, 0, 0, 148,
+    152, 0, 0, 0, 148, 152, 0, 0, 0, 148, 152, 0, 0, 0, 27, 182, 240, 217, 98, 255, 20, 0, 196, 158,
+    9, 20, 190, 255, 20, 36, 255, 18, 0, 0, 63, 255, 20, 63, 243, 0, 0, 0, 32, 255, 20, 36, 255, 18,
+    0, 0, 63, 255, 20, 0, 198, 158, 9, 20, 190, 255, 20, 0, 29, 183, 240, 217, 103, 255, 13, 0, 0, 0,
+    0, 0, 66, 238, 0, 0, 51, 38, 0, 27, 199, 149, 0, 0, 75, 223, 240, 227, 150, 13, 0, 208, 92, 0,
+    0, 0, 0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 119, 186, 246, 213, 61,
+    0, 208, 224, 54, 8, 128, 225, 0, 208, 120, 0, 0, 20, 255, 23, 208, 92, 0, 0, 8, 255, 36, 208, 92,
+    0, 0, 8, 255, 36, 208, 92, 0, 0, 8, 255, 36, 208, 92, 0, 0, 8, 255, 36, 200, 100, 84, 42, 0,
+    0, 200, 100, 200, 100, 200, 100, 200, 100, 200, 100, 200, 100, 200, 100, 0, 0, 200, 100, 0, 0, 84, 42, 0,
+    0, 0, 0, 0, 0, 200, 100, 0, 0, 200, 100, 0, 0, 200, 100, 0, 0, 200, 100, 0, 0, 200, 100, 0,
+    0, 200, 100, 0, 0, 200, 100, 0, 0, 203, 94, 0, 15, 236, 59, 57, 240, 157, 0, 208, 92, 0, 0, 0,
+    0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 92, 0, 10, 177, 181, 11, 208,
+    92, 24, 203, 151, 3, 0, 208, 134, 222, 119, 0, 0, 0, 208, 232, 212, 12, 0, 0, 0, 208, 96, 167, 199,
+    17, 0, 0, 208, 92, 2, 155, 208, 22, 0, 208, 92, 0, 0, 142, 216, 28, 200, 100, 200, 100, 200, 100, 200,
+    100, 200, 100, 200, 100, 200, 100, 200, 100, 200, 100, 200, 100, 208, 123, 192, 247, 208, 42, 95, 224, 241, 149, 1,
+    208, 221, 49, 9, 162, 220, 157, 16, 37, 236, 78, 208, 118, 0, 0, 67, 255, 16, 0, 0, 167, 131, 208, 92,
+    0, 0, 56, 244, 0, 0, 0, 156, 144, 208, 92, 0, 0, 56, 244, 0, 0, 0, 156, 144, 208, 92, 0, 0,
+    56, 244, 0, 0, 0, 156, 144, 208, 92, 0, 0, 56, 244, 0, 0, 0, 156, 144, 208, 134, 187, 212, 211, 61,
+    0, 208, 214, 21, 0, 95, 225, 0, 208, 112, 0, 0, 17, 255, 23, 208, 92, 0, 0, 8, 255, 36, 208, 92,
+    0, 0, 8, 255, 36, 208, 92, 0, 0, 8, 255, 36, 208, 92, 0, 0, 8, 255, 36, 0, 22, 166, 232, 231,
+    160, 18, 0, 0, 192, 175, 16, 19, 184, 181, 0, 34, 255, 30, 0, 0, 43, 255, 25, 63, 251, 0, 0, 0,
+    8, 255, 54, 34, 255, 28, 0, 0, 42, 255, 25, 0, 193, 170, 15, 18, 182, 182, 0, 0, 24, 167, 233, 232,
+    162, 20, 0, 208, 141, 188, 202, 203, 59, 0, 208, 222, 21, 0, 69, 240, 20, 208, 124, 0, 0, 0, 204, 102,
+    208, 99, 0, 0, 0, 179, 130, 208, 135, 0, 0, 0, 215, 102, 208, 232, 51, 3, 108, 242, 21, 208, 127, 196,
+    242, 207, 61, 0, 208, 92, 0, 0, 0, 0, 0, 208, 92, 0, 0, 0, 0, 0, 208, 92, 0, 0, 0, 0,
+    0, 0, 25, 180, 239, 217, 98, 255, 20, 0, 194, 163, 10, 21, 192, 255, 20, 35, 255, 20, 0, 0, 64, 255,
+    20, 63, 243, 0, 0, 0, 32, 255, 20, 35, 255, 20, 0, 0, 64, 255, 20, 0, 196, 160, 9, 20, 191, 255,
+    20, 0, 27, 182, 240, 218, 98, 255, 20, 0, 0, 0, 0, 0, 24, 255, 20, 0, 0, 0, 0, 0, 24, 255,
+    20, 0, 0, 0, 0, 0, 24, 255, 20, 0, 0, 0, 0, 5, 208, 137, 192, 215, 85, 208, 220, 25, 0, 0,
+    208, 120, 0, 0, 0, 208, 93, 0, 0, 0, 208, 92, 0, 0, 0, 208, 92, 0, 0, 0, 208, 92, 0, 0,
+    0, 0, 110, 223, 240, 233, 141, 0, 38, 247, 40, 0, 11, 54, 0, 33, 248, 90, 15, 0, 0, 0, 0, 80,
+    188, 244, 199, 75, 0, 0, 0, 0, 7, 103, 249, 13, 38, 69, 8, 0, 82, 248, 10, 46, 200, 240, 238, 206,
+    75, 0, 0, 204, 96, 0, 0, 0, 204, 96, 0, 0, 144, 248, 233, 220, 171, 0, 204, 96, 0, 0, 0, 204,
+    96, 0, 0, 0, 204, 96, 0, 0, 0, 202, 96, 0, 0, 0, 177, 135, 0, 0, 0, 59, 215, 239, 187, 228,
+    68, 0, 0, 28, 255, 16, 228, 68, 0, 0, 28, 255, 16, 228, 68, 0, 0, 28, 255, 16, 228, 68, 0, 0,
+    28, 255, 16, 216, 76, 0, 0, 48, 255, 16, 164, 153, 0, 4, 164, 255, 16, 30, 191, 211, 190, 111, 255, 16,
+    108, 207, 0, 0, 0, 33, 253, 32, 17, 248, 48, 0, 0, 129, 189, 0, 0, 169, 145, 0, 1, 224, 91, 0,
+    0, 72, 236, 6, 67, 240, 9, 0, 0, 2, 228, 82, 163, 152, 0, 0, 0, 0, 134, 192, 245, 54, 0, 0,
+    0, 0, 37, 255, 212, 0, 0, 0, 83, 217, 0, 0, 131, 255, 34, 0, 55, 241, 4, 17, 253, 30, 0, 199,
+    218, 102, 0, 123, 177, 0, 0, 203, 98, 14, 240, 98, 171, 0, 191, 109, 0, 0, 135, 166, 79, 183, 24, 237,
+    12, 248, 41, 0, 0, 67, 232, 148, 114, 0, 211, 124, 229, 0, 0, 0, 7, 246, 241, 46, 0, 143, 241, 161,
+    0, 0, 0, 0, 186, 233, 1, 0, 74, 255, 93, 0, 0, 26, 233, 92, 0, 0, 160, 191, 3, 0, 68, 242,
+    41, 96, 232, 24, 0, 0, 0, 128, 218, 242, 66, 0, 0, 0, 0, 24, 249, 193, 0, 0, 0, 0, 2, 185,
+    173, 230, 98, 0, 0, 0, 126, 214, 11, 64, 242, 44, 0, 65, 242, 43, 0, 0, 124, 215, 11, 105, 209, 0,
+    0, 0, 35, 252, 31, 14, 244, 53, 0, 0, 134, 184, 0, 0, 156, 152, 0, 3, 229, 83, 0, 0, 53, 241,
+    10, 77, 233, 5, 0, 0, 0, 206, 95, 176, 137, 0, 0, 0, 0, 104, 210, 250, 37, 0, 0, 0, 0, 13,
+    243, 191, 0, 0, 0, 0, 0, 1, 223, 90, 0, 0, 0, 0, 0, 92, 229, 6, 0, 0, 0, 0, 235, 231,
+    74, 0, 0, 0, 0, 64, 228, 228, 228, 230, 255, 68, 0, 0, 0, 0, 146, 205, 11, 0, 0, 0, 111, 226,
+    25, 0, 0, 0, 78, 239, 45, 0, 0, 0, 51, 240, 71, 0, 0, 0, 29, 230, 102, 0, 0, 0, 0, 112,
+    253, 228, 228, 228, 228, 60, 0, 0, 10, 186, 232, 143, 0, 0, 83, 229, 7, 0, 0, 0, 103, 200, 0, 0,
+    0, 0, 107, 198, 0, 0, 0, 4, 170, 164, 0, 0, 84, 247, 230, 32, 0, 0, 0, 8, 183, 148, 0, 0,
+    0, 0, 111, 194, 0, 0, 0, 0, 104, 200, 0, 0, 0, 0, 102, 202, 0, 0, 0, 0, 75, 236, 17, 0,
+    0, 0, 6, 161, 225, 143, 88, 188, 88, 188, 88, 188, 88, 188, 88, 188, 88, 188, 88, 188, 88, 188, 88, 188,
+    88, 188, 88, 188, 88, 188, 44, 94, 84, 229, 212, 46, 0, 0, 0, 0, 164, 150, 0, 0, 0, 0, 128, 171,
+    0, 0, 0, 0, 126, 175, 0, 0, 0, 0, 94, 223, 18, 0, 0, 0, 3, 190, 253, 145, 0, 0, 78, 231,
+    25, 0, 0, 0, 122, 178, 0, 0, 0, 0, 128, 172, 0, 0, 0, 0, 131, 169, 0, 0, 0, 3, 180, 142,
+    0, 0, 84, 228, 190, 34, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 151, 214, 198, 109, 20, 1,
+    80, 110, 146, 109, 33, 71, 169, 247, 241, 187, 36, 9, 0, 0, 0, 0, 5, 7, 0, 0,
+};
+
+const Glyph &getGlyph(char c)
+{
+    // Characters outside of printable ASCII are drawn as '?'
+    if (c < 32 || c > 126)
+    {
+        c = '?';
+    }
+    return FONT_GLYPHS[c - 32];
+}
+
+const unsigned char *getGlyphAlpha(const Glyph &glyph)
+{
+    return FONT_ALPHA + glyph.offset;
+}
@@ -0,0 +1,127 @@
+#include "format.h"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+// Enough for the longest fixed notation of a double (309 digits) plus sign, point and decimals
+static constexpr size_t NUMBER_BUFFER_SIZE = 400;
+
+TextBuffer::TextBuffer(size_t capacity)
+{
+    text.reserve(capacity);
+}
+
+void TextBuffer::clear()
+{
+    text.clear();
+}
+
+TextBuffer &TextBuffer::append(std::string_view value)
+{
+    text.append(value);
+    return *this;
+}
+
+TextBuffer &TextBuffer::append(char character)
+{
+    text.push_back(character);
+    return *this;
+}
+
+TextBuffer &TextBuffer::appendInteger(long long value)
+{
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+TextBuffer &TextBuffer::appendFixed(double value, int decimals)
+{
+    char digits[NUMBER_BUFFER_SIZE];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, decimals);
+    if (result.ec != std::errc())
+    {
+        text.append("-");
+        return *this;
+    }
+    text.append(digits, result.ptr);
+    return *this;
+}
+
+TextBuffer &TextBuffer::appendGrouped(double value, int decimals)
+{
+    char digits[NUMBER_BUFFER_SIZE];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, decimals);
+    if (result.ec != std::errc() || !std::isfinite(value))
+    {
+        return appendFixed(value, decimals);
+    }
+
+    // Split the digits into the sign, the integer part and the decimals (including the point)
+    const char *begin = digits;
+    if (*begin == '-')
+    {
+        text.push_back('-');
+        begin++;
+    }
+    const char *point = begin;
+    while (point < result.ptr && *point != '.')
+    {
+        point++;
+    }
+
+    // Insert a separator before every group of three integer digits, except the first group
+    size_t integerDigits = point - begin;
+    for (size_t i = 0; i < integerDigits; i++)
+    {
+        if (i > 0 && (integerDigits - i) % 3 == 0)
+        {
+            text.push_back(',');
+        }
+        text.push_back(begin[i]);
+    }
+    text.append(point, result.ptr - point);
+    return *this;
+}
+
+TextBuffer &TextBuffer::appendSigned(double value, int decimals)
+{
+    if (value >= 0)
+    {
+        text.push_back('+');
+    }
+    return appendFixed(value, decimals);
+}
+
+TextBuffer &TextBuffer::appendCompact(double value)
+{
+    static constexpr struct { double size; char unit; } units[] = {{1e12, 'T'}, {1e9, 'B'}, {1e6, 'M'}, {1e3, 'K'}};
+    for (const auto &unit : units)
+    {
+        if (std::abs(value) >= unit.size)
+        {
+            appendGrouped(value / unit.size, 2);
+            text.push_back(unit.unit);
+            return *this;
+        }
+    }
+    return appendFixed(value, 2);
+}
+
+std::string_view TextBuffer::view() const
+{
+    return text;
+}
+
+std::string TextBuffer::str() const
+{
+    return text;
+}
+
+TextBuffer &formatBuffer()
+{
+    static thread_local TextBuffer buffer;
+    buffer.clear();
+    return buffer;
+}
@@ -0,0 +1,359 @@
+#include "gnuplotpool.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <libproc.h>
+#endif
+
+// Maximum time a running gnuplot process gets to answer the health check of a lease
+static const std::chrono::seconds PROBE_TIMEOUT{2};
+
+// Blocks SIGPIPE on the calling thread while it writes commands to gnuplot, so that writing to a process that died
+// fails instead of ending the program. A SIGPIPE raised in the meantime is discarded; the signal handling of the
+// rest of the program is not changed.
+class SigpipeBlock
+{
+public:
+    SigpipeBlock()
+    {
+        sigemptyset(&sigpipe);
+        sigaddset(&sigpipe, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &sigpipe, &previousMask);
+        sigset_t pending;
+        sigpending(&pending);
+        wasPending = sigismember(&pending, SIGPIPE);
+    }
+
+    ~SigpipeBlock()
+    {
+        sigset_t pending;
+        sigpending(&pending);
+        if (!wasPending && sigismember(&pending, SIGPIPE))
+        {
+            int signal;
+            sigwait(&sigpipe, &signal); // Returns at once, the signal is pending
+        }
+        pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+    }
+
+    SigpipeBlock(const SigpipeBlock &) = delete;
+    SigpipeBlock &operator=(const SigpipeBlock &) = delete;
+
+private:
+    sigset_t sigpipe;
+    sigset_t previousMask;
+    bool wasPending = false;
+};
+
+// Returns the process ids of the child processes of this process
+static std::vector<pid_t> childProcesses()
+{
+    std::vector<pid_t> children;
+#ifdef __APPLE__
+    std::vector<pid_t> buffer(1024);
+    int count = proc_listchildpids(getpid(), buffer.data(), static_cast<int>(buffer.size() * sizeof(pid_t)));
+    if (count > 0)
+    {
+        children.assign(buffer.begin(), buffer.begin() + std::min<size_t>(count, buffer.size()));
+    }
+#else
+    // The parent is the fourth field of /proc/<pid>/stat, after the command name in parentheses
+    pid_t self = getpid();
+    std::error_code error;
+    for (std::filesystem::directory_iterator it("/proc", error), end; !error && it != end; it.increment(error))
+    {
+        std::string name = it->path().filename().string();
+        if (name.empty() || !std::isdigit(static_cast<unsigned char>(name[0])))
+        {
+            continue;
+        }
+        std::ifstream stat(it->path() / "stat");
+        std::string line;
+        std::getline(stat, line);
+        size_t commandEnd = line.rfind(')');
+        if (commandEnd == std::string::npos)
+        {
+            continue;
+        }
+        std::istringstream fields(line.substr(commandEnd + 1));
+        char state;
+        pid_t parent;
+        if (fields >> state >> parent && parent == self)
+        {
+            children.push_back(static_cast<pid_t>(std::stol(name)));
+        }
+    }
+#endif
+    return children;
+}
+
+// Ends the gnuplot process of a figure without waiting for it. Destroying the figure closes the pipe to gnuplot and
+// waits until the process exits, which never happens if it hangs; so a process that failed is killed first (it is not
+// reaped before the figure is destroyed, so its id cannot belong to another process yet), and the figure is destroyed
+// on a detached thread.
+static void retire(matplot::figure_handle figure, pid_t pid, bool failed)
+{
+    if (failed && pid > 0)
+    {
+        kill(pid, SIGKILL);
+    }
+    std::thread([figure = std::move(figure)]() mutable
+                {
+                    SigpipeBlock block;
+                    figure.reset(); })
+        .detach();
+}
+
+std::string readFromGnuplot(const matplot::figure_handle &figure, const std::string &extension,
+                            const std::function<void(const std::string &)> &write, std::chrono::milliseconds timeout)
+{
+    static std::atomic<unsigned> counter{0};
+    std::string pipePath = (std::filesystem::temp_directory_path() /
+                            ("equity-bot-" + std::to_string(getpid()) + "-" + std::to_string(counter++) + "." + extension))
+                               .string();
+    if (mkfifo(pipePath.c_str(), 0600) != 0)
+    {
+        std::cerr << "Could not create pipe for gnuplot: " << std::strerror(errno) << std::endl;
+        return "";
+    }
+
+    // Open the read end first; without O_NONBLOCK this would block until gnuplot opens the other end
+    int fd = open(pipePath.c_str(), O_RDONLY | O_NONBLOCK);
+    if (fd < 0)
+    {
+        std::cerr << "Could not open pipe for gnuplot: " << std::strerror(errno) << std::endl;
+        std::filesystem::remove(pipePath);
+        return "";
+    }
+
+    {
+        SigpipeBlock block;
+        write(pipePath);
+        if (auto gnuplot = std::dynamic_pointer_cast<matplot::backend::gnuplot>(figure->backend()))
+        {
+            gnuplot->flush_commands();
+        }
+    }
+
+    // Read until gnuplot closes the pipe. Reading nothing (end-of-file) before the first byte only means that gnuplot
+    // has not opened the pipe yet; once it has, a read without data fails with EAGAIN until the next bytes arrive.
+    std::string bytes;
+    bool finished = false;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    char buffer[65536];
+    while (!finished)
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            break;
+        }
+
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0)
+        {
+            bytes.append(buffer, n);
+        }
+        else if (n == 0 && !bytes.empty())
+        {
+            finished = true;
+        }
+        else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            std::cerr << "Could not read from gnuplot: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        else
+        {
+            // Wait for data; without a writer some systems report the pipe as readable at once, so wait at most 10 ms then
+            pollfd readable{fd, POLLIN, 0};
+            poll(&readable, 1, static_cast<int>(std::min<long long>(remaining.count(), n == 0 ? 10 : 100)));
+        }
+    }
+    close(fd); // gnuplot gets an error on its next write if it is still writing
+    std::filesystem::remove(pipePath);
+
+    if (!finished)
+    {
+        std::cerr << "Timed out while waiting for gnuplot." << std::endl;
+        return "";
+    }
+    return bytes;
+}
+
+GnuplotPool::Lease::Lease(GnuplotPool &pool, size_t index) : pool(pool), index(index)
+{
+}
+
+GnuplotPool::Lease::~Lease()
+{
+    pool.release(index, failed);
+}
+
+matplot::figure_handle GnuplotPool::Lease::figure() const
+{
+    return pool.workers[index].figure;
+}
+
+matplot::axes_handle GnuplotPool::Lease::axes() const
+{
+    return pool.workers[index].figure->current_axes();
+}
+
+void GnuplotPool::Lease::fail()
+{
+    failed = true;
+}
+
+GnuplotPool::GnuplotPool(size_t size, size_t maxRenders) : workers(std::max<size_t>(size, 1)), maxRenders(maxRenders)
+{
+    counters.size = workers.size();
+}
+
+GnuplotPool::Lease GnuplotPool::lease(unsigned width, unsigned height)
+{
+    size_t index = 0;
+    bool restart = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto isFree = [this]()
+        { return std::any_of(workers.begin(), workers.end(), [](const Worker &worker)
+                             { return !worker.busy; }); };
+        if (!isFree())
+        {
+            auto start = std::chrono::steady_clock::now();
+            available.wait(lock, isFree);
+            counters.waits++;
+            counters.waitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        // Prefer a worker whose gnuplot process is already running
+        index = workers.size();
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            if (!workers[i].busy && (index == workers.size() || (workers[i].figure && !workers[index].figure)))
+            {
+                index = i;
+            }
+        }
+
+        Worker &worker = workers[index];
+        worker.busy = true;
+        counters.busy++;
+        counters.leases++;
+
+        // Health check: a worker whose last render failed, or that reached the maximum number of renders, gets a new process
+        restart = !worker.figure || !worker.healthy || worker.renders >= maxRenders;
+        if (!worker.figure)
+        {
+            counters.running++;
+        }
+        else if (restart)
+        {
+            counters.recycled++;
+        }
+    }
+
+    // The worker is leased, so nobody else touches it until it is released
+    Worker &worker = workers[index];
+    try
+    {
+        // Health check of a running process: it must answer a command, otherwise it died or hangs
+        if (!restart && !isResponsive(worker.figure))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            counters.recycled++;
+            restart = true;
+            worker.healthy = false;
+        }
+
+        if (restart)
+        {
+            // The old process is ended in the background, a hanging one must not block the lease
+            if (worker.figure)
+            {
+                retire(std::move(worker.figure), worker.pid, !worker.healthy);
+                worker.figure = nullptr;
+                worker.pid = 0;
+            }
+
+            // Starting a backend is serialized, so the new child process is the one of this figure
+            static std::mutex creationMutex;
+            std::lock_guard<std::mutex> lock(creationMutex);
+            std::vector<pid_t> before = childProcesses();
+            worker.figure = std::make_shared<matplot::figure_type>(0, true);
+            for (pid_t child : childProcesses())
+            {
+                if (std::find(before.begin(), before.end(), child) == before.end())
+                {
+                    worker.pid = (worker.pid == 0) ? child : -1; // More than one new child: unknown
+                }
+            }
+            worker.pid = std::max<pid_t>(worker.pid, 0);
+            worker.renders = 0;
+            worker.healthy = true;
+        }
+        worker.renders++;
+        worker.figure->size(width, height);
+        worker.figure->current_axes()->clear(); // Removes the plots, limits, labels and ticks of the previous render
+    }
+    catch (...)
+    {
+        // The worker goes back to the pool and is restarted by the next lease
+        if (!worker.figure)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            counters.running--; // Counted again when the next lease starts it
+        }
+        release(index, true);
+        throw;
+    }
+    return Lease(*this, index);
+}
+
+void GnuplotPool::release(size_t index, bool failed)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Worker &worker = workers[index];
+        worker.busy = false;
+        worker.healthy = !failed;
+        counters.busy--;
+        if (failed)
+        {
+            counters.failures++;
+        }
+    }
+    available.notify_one();
+}
+
+bool GnuplotPool::isResponsive(const matplot::figure_handle &figure)
+{
+    // Let gnuplot print a line into a pipe; only a process that reads and runs its commands does so
+    std::string answer = readFromGnuplot(figure, "txt", [&figure](const std::string &pipePath)
+                                         {
+                                             figure->backend()->run_command("set print \"" + pipePath + "\"");
+                                             figure->backend()->run_command("print \"ok\"");
+                                             figure->backend()->run_command("unset print"); },
+                                         PROBE_TIMEOUT);
+    return !answer.empty();
+}
+
+GnuplotPoolStats GnuplotPool::stats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
@@ -10,6 +10,7 @@
 #define BOT_H
 
 #include <dpp/dpp.h>
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <string>
@@ -17,21 +18,43 @@
 #include <vector>
 #include "data.h"
 #include "visualize.h"
+#include "commands.h"
+#include "catalogwatcher.h"
+#include "dashboard.h"
+#include "quoterefresher.h"
+#include "progressivereply.h"
+#include "symbolindex.h"
+#include "telemetry.h"
 
 class Bot
 {
 public:
-    Bot(const std::string &token);
+    /// Creates the bot.
+    /// @param token The Discord bot token.
+    /// @param shards Total number of shards (0 = let Discord decide).
+    /// @param clusterId ID of this process, between 0 and maxClusters - 1.
+    /// @param maxClusters Number of processes that together run all shards. Each process runs the shards
+    ///                    for which shard_id % maxClusters == clusterId.
+    /// @param metricsPort Port of the Prometheus metrics listener on 127.0.0.1 (0 = no listener).
+    Bot(const std::string &token, uint32_t shards = 0, uint32_t clusterId = 0, uint32_t maxClusters = 1, uint16_t metricsPort = METRICS_PORT);
 
     void run();
 
 private:
     void setupBot();
     void commandHandler(const dpp::slashcommand_t &event);
+    void autocompleteHandler(const dpp::autocomplete_t &event);
     void onReady(const dpp::ready_t &event);
     void registerCommands();
 
     dpp::cluster bot;
+    uint32_t clusterId;
+    CatalogWatcher catalog; // Groups of symbols of the catalog files, reloaded when a file changes
+    CommandHandler commands; // Logic of the slash commands (including the prebuilt replies of commands without options)
+    QuoteRefresher quotes; // Keeps the quotes of all catalog symbols fresh
+    DashboardScheduler dashboards; // Pre-renders the charts of the catalog groups
+    uint16_t metricsPort;
+    MetricsServer metrics; // Serves the latency histograms and counters
 };
 
 #endif // BOT_H
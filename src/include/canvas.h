@@ -0,0 +1,112 @@
+/// @file canvas.h
+/// @author EtoileScintillante
+/// @brief The following file contains a small RGBA canvas with anti-aliased drawing of lines,
+///        rectangles and (rotated) text, plus a PNG encoder. It is used by the native chart renderer,
+///        so charts can be drawn in-process without Matplot++ and gnuplot.
+/// @date 2026-10-18
+
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Color with 8-bit channels; a is the opacity (255 = opaque)
+struct Color
+{
+    std::uint8_t r = 0;
+    std::uint8_t g = 0;
+    std::uint8_t b = 0;
+    std::uint8_t a = 255;
+};
+
+class Canvas
+{
+public:
+    /// Creates a canvas filled with a background color.
+    /// @param width Width in pixels.
+    /// @param height Height in pixels.
+    /// @param background Background color.
+    Canvas(int width, int height, Color background);
+
+    int width() const;
+    int height() const;
+
+    /// Returns the pixels (4 bytes per pixel, RGBA, row by row).
+    const std::vector<std::uint8_t> &pixels() const;
+
+    /// Fills a rectangle. Coordinates are in pixels and may be fractional (edges are anti-aliased).
+    /// @param x0 Left edge.
+    /// @param y0 Top edge.
+    /// @param x1 Right edge.
+    /// @param y1 Bottom edge.
+    /// @param color Fill color.
+    void fillRect(double x0, double y0, double x1, double y1, Color color);
+
+    /// Draws an anti-aliased line with round ends.
+    /// @param x0 X coordinate of the start point.
+    /// @param y0 Y coordinate of the start point.
+    /// @param x1 X coordinate of the end point.
+    /// @param y1 Y coordinate of the end point.
+    /// @param lineWidth Width of the line in pixels.
+    /// @param color Line color.
+    void drawLine(double x0, double y0, double x1, double y1, double lineWidth, Color color);
+
+    /// Draws connected line segments through the given points. Overlapping segments are blended
+    /// only once, so joints of (semi-transparent or anti-aliased) lines do not get darker.
+    /// @param xs X coordinates of the points.
+    /// @param ys Y coordinates of the points.
+    /// @param lineWidth Width of the line in pixels.
+    /// @param color Line color.
+    void drawPolyline(const std::vector<double> &xs, const std::vector<double> &ys, double lineWidth, Color color);
+
+    /// Returns the width of a text in pixels.
+    /// @param text The text.
+    static double textWidth(const std::string &text);
+
+    /// Draws a text, optionally rotated around its anchor point.
+    /// The anchor is at the vertical middle of the capitals, and horizontally at the left (hAlign = 0),
+    /// center (hAlign = 0.5) or right (hAlign = 1) of the text.
+    /// @param text The text.
+    /// @param x X coordinate of the anchor.
+    /// @param y Y coordinate of the anchor.
+    /// @param color Text color.
+    /// @param hAlign Horizontal alignment (0 to 1).
+    /// @param angle Counter-clockwise rotation in degrees.
+    void drawText(const std::string &text, double x, double y, Color color, double hAlign = 0, double angle = 0);
+
+    /// Encodes the canvas as a PNG image (8-bit RGB).
+    /// @param compressionLevel zlib compression level (0 = none, 9 = smallest).
+    /// @return The PNG file contents.
+    std::string encodePNG(int compressionLevel = 6) const;
+
+    /// Encodes the canvas as a palette-indexed PNG image, with 1, 2, 4 or 8 bits per pixel depending on the
+    /// number of colors. If the canvas has more colors than fit in the palette, the most frequent colors are
+    /// kept and every other color is replaced by the closest color in the palette (this mainly affects
+    /// the anti-aliased edges).
+    /// @param compressionLevel zlib compression level (0 = none, 9 = smallest).
+    /// @param maxColors Maximum size of the palette (2 to 256).
+    /// @return The PNG file contents.
+    std::string encodePalettePNG(int compressionLevel = 9, int maxColors = 256) const;
+
+    /// Starts recording all following drawing operations, so that encodeSVG can reproduce them as vector graphics.
+    void recordSVG();
+
+    /// Returns the drawing operations recorded since recordSVG as an SVG image.
+    /// @return The SVG file contents, or an empty string if nothing was recorded.
+    std::string encodeSVG() const;
+
+private:
+    // Blends a color into a pixel; coverage (0 to 1) scales the opacity of the color
+    void blend(int x, int y, Color color, float coverage);
+
+    int w;
+    int h;
+    std::vector<std::uint8_t> rgba;
+    Color background;
+    bool recording = false;
+    std::string svg; // Recorded SVG elements
+};
+
+#endif // CANVAS_H
@@ -0,0 +1,105 @@
+/// @file catalog.h
+/// @author EtoileScintillante
+/// @brief The following file contains the catalog: all groups of symbols from the JSON files in the folder "data"
+///        (regions of indices, industries, commodities, currencies and cryptocurrencies). The files are read
+///        and parsed once, so commands can look up a group without file I/O or JSON parsing.
+/// @date 2026-10-18
+
+#ifndef CATALOG_H
+#define CATALOG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "data.h"
+
+// Names of the catalog files (without ".json") in the data folder (inline, so all translation units share one copy)
+inline const std::vector<std::string> CATALOG_FILES = {"indices", "industries", "commodities", "currencies"};
+
+// A group of symbols, such as the region "US" of the catalog "indices"
+struct CatalogGroup
+{
+    std::string catalog;                   // Name of the catalog file (e.g. "indices")
+    std::string key;                       // Key of the group in the file (e.g. "US", "Automotive")
+    std::vector<std::string> symbols;      // Symbols of the equities
+    std::vector<std::string> names;        // Names (same order as the symbols)
+    std::vector<std::string> descriptions; // Descriptions (same order as the symbols), empty if not every entry has one
+};
+
+class Catalog
+{
+public:
+    /// Reads all catalog files (CATALOG_FILES) from a folder.
+    /// Files that cannot be read are reported and skipped.
+    /// @param directory Path to the data folder.
+    /// @return The catalog.
+    static std::shared_ptr<const Catalog> load(const std::string &directory);
+
+    /// Creates a copy of this catalog in which the groups of one file are read again.
+    /// @param directory Path to the data folder.
+    /// @param name Name of the catalog file (e.g. "indices").
+    /// @return The new catalog, or nullptr if the file could not be read or is not valid.
+    std::shared_ptr<const Catalog> withReloadedFile(const std::string &directory, const std::string &name) const;
+
+    /// Looks up a group.
+    /// @param catalog Name of the catalog file (e.g. "indices").
+    /// @param key Key of the group (e.g. "US").
+    /// @return The group, or nullptr if there is no such group.
+    const CatalogGroup *find(const std::string &catalog, const std::string &key) const;
+
+    /// Returns all groups (in the order of the files).
+    const std::vector<CatalogGroup> &groups() const;
+
+    /// Returns every symbol of the catalog once.
+    std::vector<std::string> allSymbols() const;
+
+    /// Returns the generation of the catalog: every catalog that is loaded or reloaded gets a higher one,
+    /// so it tells two catalogs apart even if one was freed and the other got its address.
+    std::uint64_t generation() const;
+
+private:
+    // Returns the next generation number
+    static std::uint64_t nextGeneration();
+
+    // Reads all groups of one JSON file (nothing is added if the file is not valid)
+    bool loadFile(const std::string &path, const std::string &catalog);
+
+    // Adds a group and makes it findable
+    void addGroup(CatalogGroup group);
+
+    std::vector<CatalogGroup> groupList;
+    std::unordered_map<std::string, size_t> index; // "catalog/key" -> position in groupList
+    std::uint64_t generationNumber = nextGeneration();
+};
+
+/// Fetches the latest prices of the symbols of a catalog group and formats them (see getFormattedPrices).
+/// If the group does not exist, it will return "Error: Invalid key.".
+/// @param catalog The catalog.
+/// @param name Name of the catalog file (e.g. "indices").
+/// @param key Key of the group (e.g. "US").
+/// @param markdown When set to true, the formatted string will contain Markdown syntax to make it more visually appealing.
+/// @param description When set to true, the descriptions of the group will be added to the formatted string.
+/// @param closedWarning When set to true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param marketOpen Optional output; set to true if the market of at least one of the symbols is open.
+/// @return A string with the formatted price data (and optionally descriptions).
+std::string getFormattedGroup(const Catalog &catalog, const std::string &name, const std::string &key, bool markdown = false,
+                              bool description = false, bool closedWarning = false, bool *marketOpen = nullptr);
+
+/// Same as getFormattedGroup, but the output style is chosen at compile time.
+/// @tparam Style Markdown or PlainText.
+/// @tparam ClosedWarning When true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param catalog The catalog.
+/// @param name Name of the catalog file (e.g. "indices").
+/// @param key Key of the group (e.g. "US").
+/// @param description When set to true, the descriptions of the group will be added to the formatted string.
+/// @param marketOpen Optional output; set to true if the market of at least one of the symbols is open.
+/// @param progress Optional function that receives the partial text while the prices are fetched (see getFormattedPrices).
+/// @param unavailable Optional output; receives the number of symbols whose price could not be fetched.
+/// @return A string with the formatted price data (and optionally descriptions).
+template <class Style, bool ClosedWarning = false>
+std::string getFormattedGroup(const Catalog &catalog, const std::string &name, const std::string &key, bool description = false,
+                              bool *marketOpen = nullptr, const PriceProgress &progress = nullptr, size_t *unavailable = nullptr);
+
+#endif // CATALOG_H
@@ -0,0 +1,60 @@
+/// @file catalogwatcher.h
+/// @author EtoileScintillante
+/// @brief The following file contains a watcher that reloads the catalog when one of its JSON files changes,
+///        so edited lists are live without restarting the bot. Changes are detected with inotify on Linux
+///        and by polling the modification times elsewhere (e.g. macOS).
+///        Every reload builds a new, immutable catalog that is published with a single atomic shared_ptr store,
+///        so readers never see a half-built catalog, and a replaced catalog is freed once its last reader is done.
+/// @date 2026-10-18
+
+#ifndef CATALOGWATCHER_H
+#define CATALOGWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "catalog.h"
+
+// Interval at which the modification times are checked when inotify is not available
+constexpr std::chrono::seconds CATALOG_POLL_INTERVAL{2};
+
+class CatalogWatcher
+{
+public:
+    /// Loads the catalog from a folder.
+    /// @param directory Path to the data folder.
+    explicit CatalogWatcher(const std::string &directory);
+
+    /// Stops watching.
+    ~CatalogWatcher();
+
+    CatalogWatcher(const CatalogWatcher &) = delete;
+    CatalogWatcher &operator=(const CatalogWatcher &) = delete;
+
+    /// Starts watching the catalog files on a background thread.
+    void start();
+
+    /// Returns the current catalog. A reload does not change the returned catalog, which stays valid as long as
+    /// the caller holds it, so a command sees one catalog from start to end.
+    std::shared_ptr<const Catalog> current() const;
+
+    /// Reads one catalog file again and publishes the new catalog if the file is valid.
+    /// @param name Name of the catalog file (e.g. "indices").
+    /// @return True if the new catalog was published.
+    bool reload(const std::string &name);
+
+private:
+    // Waits for changes until the watcher is stopped
+    void watch();
+
+    std::string directory;
+    std::shared_ptr<const Catalog> published; // Only accessed with std::atomic_load and std::atomic_store
+    std::mutex reloadMutex;
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+};
+
+#endif // CATALOGWATCHER_H
@@ -0,0 +1,68 @@
+/// @file commands.h
+/// @author EtoileScintillante
+/// @brief The following file contains the logic of the slash commands without any Discord dependency:
+///        a command name and its options go in, the reply (text and optionally a chart) comes out.
+///        The bot sends these replies to Discord; the load generator (tools/loadgen.cpp) runs the same
+///        code with synthetic interactions.
+/// @date 2026-10-18
+
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include "catalog.h"
+#include "data.h"
+#include "responsecache.h"
+
+// Values of the options of a slash command by name (all options of the commands are strings)
+using CommandOptions = std::map<std::string, std::string>;
+
+// Reply to a slash command
+struct CommandReply
+{
+    std::string content;      // Text of the reply; nothing should be sent if it is empty and there is no file
+    std::string fileName;     // Name of the attached chart (e.g. "price_graph.png"), empty without chart
+    std::string fileContents; // Encoded chart
+    std::string fileMimeType; // MIME type of the chart
+};
+
+class CommandHandler
+{
+public:
+    /// Function that returns the current catalog.
+    using CatalogSource = std::function<std::shared_ptr<const Catalog>()>;
+
+    /// Creates the handler and registers the cached replies (/commodities, /currencies and /crypto).
+    /// @param catalog Function that returns the current catalog.
+    explicit CommandHandler(CatalogSource catalog);
+
+    /// Runs a command on the calling thread.
+    /// @param command Name of the command (e.g. "latestprice").
+    /// @param options Values of the options by name; missing options count as empty.
+    /// @param progress Optional function that receives the partial text of replies that are built in batches
+    ///                 (see isProgressive).
+    /// @return The reply.
+    CommandReply execute(const std::string &command, const CommandOptions &options, const PriceProgress &progress = nullptr);
+
+    /// Returns true if the reply of a command is built in batches and has prices that still have to be fetched,
+    /// so it is worth showing before it is complete. Replies from cached quotes are complete at once.
+    /// @param command Name of the command.
+    /// @param options Values of the options by name.
+    bool isProgressive(const std::string &command, const CommandOptions &options) const;
+
+    /// Adds the symbols of the catalog to the symbol index if the catalog was reloaded since the last call.
+    void syncSymbolIndex();
+
+    /// Returns the cache of the replies of commands without options; refreshExpiring should be called periodically.
+    ResponseCache &responses();
+
+private:
+    CatalogSource catalog;
+    ResponseCache responseCache; // Prebuilt replies of commands without options
+    std::atomic<std::uint64_t> indexedGeneration{0}; // Generation of the catalog whose symbols were last added to the symbol index
+};
+
+#endif // COMMANDS_H
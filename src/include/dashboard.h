@@ -0,0 +1,62 @@
+/// @file dashboard.h
+/// @author EtoileScintillante
+/// @brief The following file contains a scheduler that periodically pre-renders the charts of every symbol
+///        in a set of catalog groups (such as the regions of indices.json and the industries of industries.json).
+///        The charts are stored in the render cache, so users asking for them get them instantly,
+///        and the render work moves from request time to idle time.
+/// @date 2026-10-18
+
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <dpp/dpp.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "catalog.h"
+
+// A chart that is pre-rendered for every symbol of a dashboard group
+struct DashboardChart
+{
+    bool candlestick;   // Candlestick chart (true) or price graph (false)
+    std::string period; // Period in the format: 1y, 6mo, 2w, 12d, etc.
+    int mode;           // Display mode of a price graph (1, 2, or 3)
+    bool withVolume;    // Volumes in a candlestick chart
+};
+
+// Interval between two rounds of pre-rendering; the charts are served without refetching until the next round
+constexpr std::chrono::seconds DASHBOARD_INTERVAL{600};
+
+class DashboardScheduler
+{
+public:
+    /// Function that returns the current catalog.
+    using CatalogSource = std::function<std::shared_ptr<const Catalog>()>;
+
+    /// Creates the scheduler.
+    /// @param catalogSource Function that returns the current catalog.
+    /// @param catalogs Names of the catalogs whose groups are dashboards (e.g. "indices").
+    /// @param charts Charts that are pre-rendered for every symbol of every group.
+    DashboardScheduler(CatalogSource catalogSource, std::vector<std::string> catalogs, std::vector<DashboardChart> charts);
+
+    /// Renders all dashboards in the background now and then every DASHBOARD_INTERVAL, using a timer of the cluster.
+    /// @param bot The cluster whose timer is used.
+    void start(dpp::cluster &bot);
+
+    /// Renders all dashboards on the calling thread.
+    /// @return The number of charts that were created (or were already up to date).
+    size_t renderAll();
+
+private:
+    // Starts renderAll on a background thread, unless the previous round is still running
+    void renderInBackground();
+
+    CatalogSource catalogSource;
+    std::vector<std::string> catalogs;
+    std::vector<DashboardChart> charts;
+    std::atomic<bool> rendering{false};
+};
+
+#endif // DASHBOARD_H
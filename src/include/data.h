@@ -21,7 +21,9 @@
 #include <iomanip>
 #include <regex>
 #include <unordered_map>
+#include <functional>
 #include "rapidjson/document.h"
+#include "format.h"
 
 // Struct with equity metrics
 // Note that this can also be used for futures, indices and crypto, but in that case some attributes will remain empty
@@ -65,6 +67,23 @@ struct GainLoss {
 /// @param userdata Pointer to the string object where the received data will be stored; the function appends the received data to this string.
 static size_t WriteCallback(char *ptr, size_t size, size_t nmemb, std::string *userdata);
 
+// Base URL of the Yahoo Finance API
+constexpr const char *DEFAULT_UPSTREAM_URL = "https://query1.finance.yahoo.com";
+
+// Maximum time to connect to Yahoo Finance, and maximum time of a whole request, so a stalled connection
+// cannot block the thread that waits for it (e.g. the quote refresher) indefinitely
+constexpr std::chrono::seconds UPSTREAM_CONNECT_TIMEOUT{5};
+constexpr std::chrono::seconds UPSTREAM_TIMEOUT{10};
+
+/// Function to change the base URL of all Yahoo Finance requests, e.g. to a local stand-in that replays
+/// recorded responses (see tools/replayserver.cpp). Must be called before any data is fetched.
+/// @param url The base URL without trailing slash (e.g. "http://127.0.0.1:8480").
+void setUpstreamUrl(const std::string &url);
+
+/// Function to get the base URL of all Yahoo Finance requests.
+/// @return The base URL (DEFAULT_UPSTREAM_URL unless it was changed with setUpstreamUrl).
+const std::string &upstreamUrl();
+
 /// Function to convert a duration to time in seconds.
 /// @param duration The duration in the format: 1y, 6mo, 2w, 12d, etc.
 /// @return The duration in seconds.
@@ -80,6 +99,12 @@ std::time_t convertToUnixTimestamp(const std::string &date);
 /// @return The HTTP response as a string.
 static std::string httpGet(const std::string &url);
 
+/// Function to perform several HTTP GET requests concurrently using libcurl's multi interface.
+/// @param urls The URLs to request.
+/// @param maxConnections Maximum number of transfers at the same time (the others wait in a queue).
+/// @return The responses, in the same order as the URLs (empty if a request failed).
+std::vector<std::string> httpGetBatch(const std::vector<std::string> &urls, long maxConnections = 8);
+
 /// Function to fetch historical stock/future/index data from Yahoo Finance and store OHLC data (and dates and volumes) in a 2D vector.
 /// The interval of the data is one day.
 /// @param symbol The symbol of the stock/future/index/crypto.
@@ -88,6 +113,11 @@ static std::string httpGet(const std::string &url);
 /// @note Function is named fetch*OHLC*Data but this also includes dates (in format y/m/d) and volumes.
 std::vector<std::vector<std::string>> fetchOHLCData(const std::string &symbol, const std::string &duration);
 
+/// Function to parse a Yahoo Finance history (CSV) response; the header line is skipped.
+/// @param csv The response of the download endpoint.
+/// @return A 2D vector where each row contains the following data: date, open, high, low, close, volume (in that order).
+std::vector<std::vector<std::string>> parseOHLCData(const std::string &csv);
+
 /// Function to fetch the latest price and % of change compared to the opening price of a stock/future/index/crypto from Yahoo Finance.
 /// Data will be returned in a string as follows: "The latest price of {symbol}: {latestPrice} (%change)".
 /// If something went wrong, it will return the following string: "Could not fetch latest price data. Symbol may be invalid."
@@ -97,11 +127,40 @@ std::vector<std::vector<std::string>> fetchOHLCData(const std::string &symbol, c
 /// @return A string containing the latest price and % change information.
 std::string getFormattedPrice(const std::string &symbol, bool markdown = false, bool closedWarning = false);
 
+/// Same as getFormattedPrice, but the output style is chosen at compile time.
+/// @tparam Style Markdown or PlainText.
+/// @tparam ClosedWarning When true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param symbol The symbol of the stock/future/index/crypto.
+/// @return A string containing the latest price and % change information.
+template <class Style, bool ClosedWarning = false>
+std::string getFormattedPrice(const std::string &symbol);
+
+/// Function to format the latest price and % of change of already fetched metrics (see getFormattedPrice).
+/// @tparam Style Markdown or PlainText.
+/// @tparam ClosedWarning When true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param data Metrics struct of the stock/future/index/crypto.
+/// @return A string containing the latest price and % change information.
+template <class Style, bool ClosedWarning = false>
+std::string formatPrice(const Metrics &data);
+
+/// Function to extract the metrics from a Yahoo Finance options response.
+/// @param symbol The symbol of the stock/future/index/crypto (used in error messages).
+/// @param response The response of the options endpoint.
+/// @return Metrics struct containing price info, market capitalization and more (symbol is "-" if the response is not valid).
+Metrics parseMetrics(const std::string &symbol, const std::string &response);
+
 /// Function to fetch stock/future/index/crypto metrics from Yahoo Finance API for a single symbol.
+/// A valid quote from the quote cache (or the shared cache) is returned without contacting Yahoo Finance.
 /// @param symbol The symbol of the stock/future/index/crypto.
 /// @return Metrics struct containing price info, market capitalization and more.
 Metrics fetchMetrics(const std::string &symbol);
 
+/// Function to fetch the metrics of several symbols with concurrent requests, bypassing the quote cache
+/// (but not the shared cache). The results are stored in the quote cache.
+/// @param symbols The symbols of the stocks/futures/indices/crypto.
+/// @return Metrics structs in the same order as the symbols.
+std::vector<Metrics> fetchMetricsBatch(const std::vector<std::string> &symbols);
+
 /// Function to get stock/future/index/crypto metrics in a readable way.
 /// When data is not available, it will return "Could not fetch data. Symbol may be invalid.".
 /// @param symbol The symbol of the stock/future/index/crypto.
@@ -109,6 +168,21 @@ Metrics fetchMetrics(const std::string &symbol);
 /// @return A string with the metrics.
 std::string getFormattedMetrics(const std::string &symbol, bool markdown = false);
 
+/// Same as getFormattedMetrics, but the output style is chosen at compile time.
+/// @tparam Style Markdown or PlainText.
+/// @param symbol The symbol of the stock/future/index/crypto.
+/// @return A string with the metrics.
+template <class Style>
+std::string getFormattedMetrics(const std::string &symbol);
+
+/// Function to format already fetched metrics in a readable way (see getFormattedMetrics).
+/// Prices get thousands separators and the market cap is shown in compact units (e.g. 2.85T).
+/// @tparam Style Markdown or PlainText.
+/// @param metrics Metrics struct of the stock/future/index/crypto.
+/// @return A string with the metrics.
+template <class Style>
+std::string formatMetrics(const Metrics &metrics);
+
 /// Function that takes a vector of symbols, loops over all of them and fetches their latest price data.
 /// It then formats the data (latest price + percentage of change compared to open price) in a readable way.
 /// If no symbols are provided, it will return "No data available.".
@@ -119,9 +193,45 @@ std::string getFormattedMetrics(const std::string &symbol, bool markdown = false
 /// @param descriptions Vector of descriptions of the stocks/futures/indices/crypto. These will be added under the symbol (or name).
 /// @param markdown When set to true, the formatted string will contain Markdown syntax to make it more visually appealing.
 /// @param closedWarning When set to true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param marketOpen Optional output; set to true if the market of at least one of the symbols is open.
 /// @return A string with the formatted price data (and optionally descriptions).
 std::string getFormattedPrices(std::vector<std::string> symbols, std::vector<std::string> names = {},
-                               std::vector<std::string> descriptions = {}, bool markdown = false, bool closedWarning = false);
+                               std::vector<std::string> descriptions = {}, bool markdown = false, bool closedWarning = false,
+                               bool *marketOpen = nullptr);
+
+// Number of symbols whose prices are fetched together (concurrently) by getFormattedPrices
+constexpr size_t PRICE_BATCH_SIZE = 4;
+
+/// Function that receives the formatted text of the symbols resolved so far.
+using PriceProgress = std::function<void(const std::string &partial)>;
+
+/// Same as getFormattedPrices, but the output style is chosen at compile time.
+/// The prices are fetched in batches of PRICE_BATCH_SIZE symbols; after every batch but the last,
+/// the text formatted so far is passed to the progress function, so it can be shown before all prices are known.
+/// @tparam Style Markdown or PlainText.
+/// @tparam ClosedWarning When true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param symbols Vector of stock/index/future/crypto symbols.
+/// @param names Vector of names of the stocks/futures/indices/crypto. If names are given, they will be added instead of the symbols.
+/// @param descriptions Vector of descriptions of the stocks/futures/indices/crypto. These will be added under the symbol (or name).
+/// @param marketOpen Optional output; set to true if the market of at least one of the symbols is open.
+/// @param progress Optional function that receives the partial text after every batch.
+/// @param unavailable Optional output; receives the number of symbols whose price could not be fetched.
+/// @return A string with the formatted price data (and optionally descriptions).
+template <class Style, bool ClosedWarning = false>
+std::string getFormattedPrices(const std::vector<std::string> &symbols, const std::vector<std::string> &names = {},
+                               const std::vector<std::string> &descriptions = {}, bool *marketOpen = nullptr,
+                               const PriceProgress &progress = nullptr, size_t *unavailable = nullptr);
+
+/// Reads the symbols, names and descriptions of one group (key) of a JSON file.
+/// See the folder "data" for examples of JSON files that work with this function.
+/// @param pathToJson Path to the JSON file.
+/// @param key Key of the group (e.g. "commodities", "currencies", "Automotive").
+/// @param symbols Vector that receives the symbols.
+/// @param names Vector that receives the names.
+/// @param descriptions Vector that receives the descriptions (only of entries that have one).
+/// @return An empty string on success, otherwise an error message.
+std::string loadJSONSymbols(const std::string &pathToJson, const std::string &key, std::vector<std::string> &symbols,
+                            std::vector<std::string> &names, std::vector<std::string> &descriptions);
 
 /// This function reads JSON data containing symbols, names and optionally descriptions of things related to
 /// financial markets. It extracts the symbols and names (and descriptions) and formats the data using 
@@ -132,8 +242,10 @@ std::string getFormattedPrices(std::vector<std::string> symbols, std::vector<std
 /// @param markdown When set to true, the formatted string will contain Markdown syntax to make it more visually appealing.
 /// @param description When set to true, the descriptions provided in the JSON file will be added to the formatted string.
 /// @param closedWarning When set to true, the formatted string will contain a note in case the market of the equity is closed.
+/// @param marketOpen Optional output; set to true if the market of at least one of the symbols is open.
 /// @return A string with the formatted price data (and optionally descriptions).
-std::string getFormattedJSON(const std::string &pathToJson, const std::string &key, bool markdown = false, bool description = false, bool closedWarning = false);
+std::string getFormattedJSON(const std::string &pathToJson, const std::string &key, bool markdown = false, bool description = false,
+                             bool closedWarning = false, bool *marketOpen = nullptr);
 
 /// Function to get the top 5 biggest gains and losses (in percentage change) of a stock/future/index/crypto 
 /// during a given period. The daily opening and closing prices are used to calculate this.
@@ -143,4 +255,20 @@ std::string getFormattedJSON(const std::string &pathToJson, const std::string &k
 /// @return A formatted string with the biggest gains and losses.
 std::string getFormattedGainsLosses(const std::string &symbol, const std::string &duration, bool markdown = false);
 
+/// Same as getFormattedGainsLosses, but the output style is chosen at compile time.
+/// @tparam Style Markdown or PlainText.
+/// @param symbol The symbol of the stock/future/index/crypto.
+/// @param duration The duration/period in the format: 1y, 6mo, 2w, 12d, etc.
+/// @return A formatted string with the biggest gains and losses.
+template <class Style>
+std::string getFormattedGainsLosses(const std::string &symbol, const std::string &duration);
+
+/// Function to format the top 5 biggest gains and losses of already fetched OHLC data (see getFormattedGainsLosses).
+/// @tparam Style Markdown or PlainText.
+/// @param ohlcData OHLC data as returned by fetchOHLCData.
+/// @param currency Currency of the prices.
+/// @return A formatted string with the biggest gains and losses.
+template <class Style>
+std::string formatGainsLosses(const std::vector<std::vector<std::string>> &ohlcData, const std::string &currency);
+
 #endif // DATA_H
\ No newline at end of file
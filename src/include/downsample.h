@@ -0,0 +1,38 @@
+/// @file downsample.h
+/// @author EtoileScintillante
+/// @brief The following file contains functions to reduce the number of points of long price series
+///        before plotting. A 900 pixel wide chart cannot show more points than it has pixel columns,
+///        so reducing the data to that budget keeps the render cost bounded for any period,
+///        while keeping the shape (and the extremes) of the data.
+/// @date 2026-10-18
+
+#ifndef DOWNSAMPLE_H
+#define DOWNSAMPLE_H
+
+#include <cstddef>
+#include <vector>
+#include "visualize.h"
+
+// Minimum horizontal distance between two candles in pixels; longer periods are merged into multi-day candles
+constexpr double MIN_CANDLE_PITCH = 1.5;
+
+/// Selects at most maxPoints points of a line with the Largest-Triangle-Three-Buckets algorithm.
+/// The first and last point are always kept; from every bucket in between the point is kept that forms
+/// the largest triangle with the previously kept point and the average of the next bucket, which preserves
+/// peaks and dips. If the series is not longer than maxPoints, all points are returned.
+/// @param values The y values; the x values are their indices (0, 1, 2, ...).
+/// @param maxPoints Maximum number of points to keep (usually the width of the plot in pixels).
+/// @param xs Vector that receives the x values (indices) of the kept points.
+/// @param ys Vector that receives the y values of the kept points.
+void downsampleLTTB(const std::vector<double> &values, std::size_t maxPoints, std::vector<double> &xs, std::vector<double> &ys);
+
+/// Merges consecutive candles into at most maxCandles candles (min-max bucketing).
+/// Each merged candle opens with the first open, closes with the last close, and keeps the highest high,
+/// the lowest low and the total volume of its bucket, so no extreme gets lost. Its date is the first date of the bucket.
+/// If the data has no more than maxCandles candles, it is returned unchanged.
+/// @param data The OHLCV data.
+/// @param maxCandles Maximum number of candles.
+/// @return The merged OHLCV data.
+ChartData downsampleCandles(const ChartData &data, std::size_t maxCandles);
+
+#endif // DOWNSAMPLE_H
@@ -0,0 +1,40 @@
+/// @file font.h
+/// @author EtoileScintillante
+/// @brief The following file contains the bitmap font used by the native chart renderer.
+///        The glyphs are pre-rendered from DejaVu Sans, so no font library is needed at runtime.
+///        DejaVu fonts are free to use and redistribute (Bitstream Vera license, see https://dejavu-fonts.github.io/License.html).
+/// @date 2026-10-18
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <cstdint>
+
+// Vertical metrics of the font (in pixels)
+constexpr int FONT_ASCENT = 13;      // Distance from baseline to the top of the line
+constexpr int FONT_DESCENT = 4;      // Distance from baseline to the bottom of the line
+constexpr int FONT_LINE_HEIGHT = 17; // Ascent + descent
+constexpr int FONT_CAP_HEIGHT = 9;   // Height of capitals and digits
+
+// Single pre-rendered character
+struct Glyph
+{
+    std::int8_t left;      // Horizontal offset from the pen position to the bitmap
+    std::int8_t top;       // Distance from the baseline to the top of the bitmap
+    std::uint8_t width;    // Bitmap width
+    std::uint8_t height;   // Bitmap height
+    std::uint8_t advance;  // Distance to the next pen position
+    std::uint16_t offset;  // Offset of the bitmap in the coverage table
+};
+
+/// Returns the glyph of a character. Characters outside printable ASCII are drawn as '?'.
+/// @param c The character.
+/// @return The glyph.
+const Glyph &getGlyph(char c);
+
+/// Returns the coverage bitmap (one byte per pixel, row by row) of a glyph.
+/// @param glyph The glyph.
+/// @return Pointer to width * height coverage values.
+const unsigned char *getGlyphAlpha(const Glyph &glyph);
+
+#endif // FONT_H
@@ -0,0 +1,90 @@
+/// @file format.h
+/// @author EtoileScintillante
+/// @brief The following file contains the text buffer the reply formatters write into.
+///        Numbers are converted with std::to_chars (no locale, no stream state, no allocation)
+///        and every thread reuses one pre-reserved buffer, so formatting a reply only allocates
+///        the returned string.
+///        It also contains the output styles the formatters are specialized on at compile time.
+/// @date 2026-10-18
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Initial capacity of the formatting buffer; large enough for the longest catalog reply
+constexpr size_t FORMAT_BUFFER_RESERVE = 8192;
+
+/// Output style for Discord: headings and values in code spans (Markdown syntax).
+struct Markdown
+{
+    static constexpr bool markdown = true;
+    static constexpr std::string_view heading = "### ";
+    static constexpr std::string_view code = "`";
+};
+
+/// Output style without any markup, e.g. for logs and the terminal.
+struct PlainText
+{
+    static constexpr bool markdown = false;
+    static constexpr std::string_view heading = "";
+    static constexpr std::string_view code = "";
+};
+
+class TextBuffer
+{
+public:
+    /// Creates an empty buffer.
+    /// @param capacity Number of characters to reserve.
+    explicit TextBuffer(size_t capacity = FORMAT_BUFFER_RESERVE);
+
+    /// Removes the text but keeps the reserved memory.
+    void clear();
+
+    /// Appends text.
+    TextBuffer &append(std::string_view text);
+
+    /// Appends a single character.
+    TextBuffer &append(char character);
+
+    /// Appends an integer (e.g. 42).
+    TextBuffer &appendInteger(long long value);
+
+    /// Appends a number with a fixed number of decimals (e.g. 1234.50).
+    /// @param value The number.
+    /// @param decimals Number of decimals.
+    TextBuffer &appendFixed(double value, int decimals = 2);
+
+    /// Appends a number with a fixed number of decimals and thousands separators (e.g. 1,234.50).
+    /// @param value The number.
+    /// @param decimals Number of decimals.
+    TextBuffer &appendGrouped(double value, int decimals = 2);
+
+    /// Appends a number with a fixed number of decimals and an explicit sign for positive numbers (e.g. +1.25).
+    /// @param value The number.
+    /// @param decimals Number of decimals.
+    TextBuffer &appendSigned(double value, int decimals = 2);
+
+    /// Appends a large number in compact units with two decimals: K (thousand), M (million), B (billion) or T (trillion),
+    /// e.g. 2.85T. Numbers below one thousand are appended as they are.
+    TextBuffer &appendCompact(double value);
+
+    /// Returns the text.
+    std::string_view view() const;
+
+    /// Returns a copy of the text.
+    std::string str() const;
+
+private:
+    std::string text;
+};
+
+/// Returns the formatting buffer of the calling thread, cleared.
+/// The buffer is shared by all formatters of the thread, so a formatter must copy the text (str())
+/// before another formatter runs.
+/// @return Reference to the buffer.
+TextBuffer &formatBuffer();
+
+#endif // FORMAT_H
@@ -0,0 +1,112 @@
+/// @file gnuplotpool.h
+/// @author EtoileScintillante
+/// @brief The following file contains a fixed-size pool of long-lived Matplot++ figures, each with its own
+///        gnuplot process. Render functions lease a figure, draw into its (cleared) axes and return it,
+///        so a chart does not pay for starting a gnuplot process, and the number of processes stays bounded.
+/// @date 2026-10-18
+
+#ifndef GNUPLOTPOOL_H
+#define GNUPLOTPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <matplot/matplot.h>
+
+/// Utilization of a GnuplotPool.
+struct GnuplotPoolStats
+{
+    size_t size = 0;          // Number of workers
+    size_t running = 0;       // Workers with a started gnuplot process
+    size_t busy = 0;          // Workers that are currently leased
+    uint64_t leases = 0;      // Total number of leases
+    uint64_t waits = 0;       // Leases that had to wait for a free worker
+    double waitSeconds = 0;   // Total time spent waiting for a free worker
+    uint64_t failures = 0;    // Renders that did not deliver an image
+    uint64_t recycled = 0;    // Workers that were restarted (after a failure or after the maximum number of renders)
+};
+
+/// Makes the gnuplot process of a figure write into a named pipe and returns what it wrote.
+/// The pipe is read without blocking against a deadline, so a gnuplot process that hangs (or never opens the pipe)
+/// costs at most the timeout.
+/// @param figure The figure.
+/// @param extension Extension of the pipe (gnuplot picks the terminal of a saved figure by it, e.g. "png").
+/// @param write Function that sends the commands that open the pipe (its path is passed), write into it and close it.
+/// @param timeout Maximum time to wait until gnuplot has closed the pipe.
+/// @return What gnuplot wrote, or an empty string if it wrote nothing or did not close the pipe in time.
+std::string readFromGnuplot(const matplot::figure_handle &figure, const std::string &extension,
+                            const std::function<void(const std::string &)> &write, std::chrono::milliseconds timeout);
+
+class GnuplotPool
+{
+    struct Worker
+    {
+        matplot::figure_handle figure;
+        pid_t pid = 0; // Process id of the gnuplot process of the figure (0 if unknown)
+        size_t renders = 0;
+        bool busy = false;
+        bool healthy = true;
+    };
+
+public:
+    /// A leased worker. The worker goes back to the pool when the lease is destroyed.
+    class Lease
+    {
+    public:
+        Lease(GnuplotPool &pool, size_t index);
+        ~Lease();
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        /// Returns the figure of the worker (with its own gnuplot process).
+        matplot::figure_handle figure() const;
+
+        /// Returns the axes to draw into (cleared for every lease).
+        matplot::axes_handle axes() const;
+
+        /// Reports that the render did not deliver an image (e.g. timed out).
+        /// The worker's gnuplot process is then replaced before the worker is leased again.
+        void fail();
+
+    private:
+        GnuplotPool &pool;
+        size_t index;
+        bool failed = false;
+    };
+
+    /// Creates the pool. The gnuplot processes are started on first use.
+    /// @param size Number of workers (and thus of gnuplot processes).
+    /// @param maxRenders Number of renders after which a worker gets a fresh gnuplot process.
+    GnuplotPool(size_t size, size_t maxRenders);
+
+    /// Leases a worker, waiting for one to become free if all are busy.
+    /// A running gnuplot process must answer a command first; a process that died or hangs is replaced.
+    /// The figure is resized to the given size and its axes are cleared.
+    /// @param width Width of the figure in pixels.
+    /// @param height Height of the figure in pixels.
+    /// @return The lease.
+    Lease lease(unsigned width, unsigned height);
+
+    /// Returns the utilization of the pool.
+    GnuplotPoolStats stats();
+
+private:
+    // Returns a worker to the pool
+    void release(size_t index, bool failed);
+
+    // Returns true if the gnuplot process of a figure answers a command
+    static bool isResponsive(const matplot::figure_handle &figure);
+
+    std::vector<Worker> workers;
+    size_t maxRenders;
+    GnuplotPoolStats counters;
+    std::mutex mutex;
+    std::condition_variable available;
+};
+
+#endif // GNUPLOTPOOL_H
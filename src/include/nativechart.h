@@ -0,0 +1,28 @@
+/// @file nativechart.h
+/// @author EtoileScintillante
+/// @brief The following file contains the native chart renderer. It draws the price graph and the
+///        candlestick chart directly into an RGBA canvas and encodes it as PNG (or SVG), in the same style as the
+///        Matplot++ charts, without starting a gnuplot process.
+/// @date 2026-10-18
+
+#ifndef NATIVECHART_H
+#define NATIVECHART_H
+
+#include "visualize.h"
+
+/// Draws the price graph (open and/or close prices) with the native renderer.
+/// @param data The OHLC data (must not be empty).
+/// @param mode An integer representing the display mode (1 = open, 2 = close, 3 = both).
+/// @param options The image format.
+/// @return The encoded image.
+std::string nativePriceGraph(const ChartData &data, int mode, ImageOptions options);
+
+/// Draws the candlestick chart with the native renderer.
+/// @param data The OHLCV data (must not be empty).
+/// @param withVolume Set to true if you want to plot volumes as well.
+/// @param options The image format.
+/// @param merged Set to true if consecutive days were merged into one candle, may be nullptr.
+/// @return The encoded image.
+std::string nativeCandleChart(const ChartData &data, bool withVolume, ImageOptions options, bool *merged = nullptr);
+
+#endif // NATIVECHART_H
@@ -0,0 +1,60 @@
+/// @file progressivereply.h
+/// @author EtoileScintillante
+/// @brief The following file contains a reply that is shown while it is being built.
+///        The interaction is acknowledged right away (Discord shows "... is thinking"), after which
+///        the message is edited as parts of the reply become available. Edits are coalesced so that
+///        at most one edit per REPLY_EDIT_INTERVAL is sent, which keeps the bot within Discord's rate limits.
+///        Nothing waits for Discord: text that cannot be shown yet is kept and sent with the next edit.
+/// @date 2026-10-18
+
+#ifndef PROGRESSIVEREPLY_H
+#define PROGRESSIVEREPLY_H
+
+#include <dpp/dpp.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Minimum time between two edits of the same reply
+constexpr std::chrono::milliseconds REPLY_EDIT_INTERVAL{1000};
+
+class ProgressiveReply
+{
+public:
+    /// Sends the deferred reply of a slash command.
+    /// @param event The slash command.
+    explicit ProgressiveReply(const dpp::slashcommand_t &event);
+
+    /// Shows a partial reply. If the deferred reply is not acknowledged yet, or the previous edit was less than
+    /// REPLY_EDIT_INTERVAL ago, the text is kept instead: it is shown as soon as the deferred reply is acknowledged,
+    /// unless a newer update or finish replaces it first (so with fast batches, only the final text may be shown).
+    /// @param content The reply built so far.
+    void update(const std::string &content);
+
+    /// Shows the complete reply; if the deferred reply is not acknowledged yet, it is shown once it is.
+    /// Does not block.
+    /// @param content The reply.
+    void finish(const std::string &content);
+
+private:
+    // State shared with the callback of the deferred reply, which may run after the reply object is gone
+    struct State
+    {
+        explicit State(const dpp::slashcommand_t &event) : event(event) {}
+
+        // Sends an edit of the reply (must hold the lock)
+        void edit(const std::string &content);
+
+        dpp::slashcommand_t event;
+        std::mutex mutex;
+        bool acknowledged = false; // Discord has processed the deferred reply, so it can be edited
+        bool finished = false;     // The complete reply was passed to finish
+        std::string pending;       // Newest text that has not been shown yet
+        std::chrono::steady_clock::time_point lastEdit{};
+    };
+
+    std::shared_ptr<State> state;
+};
+
+#endif // PROGRESSIVEREPLY_H
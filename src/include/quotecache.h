@@ -0,0 +1,57 @@
+/// @file quotecache.h
+/// @author EtoileScintillante
+/// @brief The following file contains the in-process cache of quotes (Metrics). fetchMetrics answers from it while
+///        a quote is valid; how long that is depends on the market state of the equity. The QuoteRefresher
+///        keeps the quotes of all catalog symbols valid, so catalog commands never wait for Yahoo Finance.
+/// @date 2026-10-18
+
+#ifndef QUOTECACHE_H
+#define QUOTECACHE_H
+
+#include <chrono>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "data.h"
+
+// How long a quote stays valid, depending on the market state
+constexpr std::chrono::seconds QUOTE_TTL_OPEN{15};     // Regular trading hours
+constexpr std::chrono::seconds QUOTE_TTL_EXTENDED{45}; // Pre-market and after-hours trading
+constexpr std::chrono::seconds QUOTE_TTL_CLOSED{120};  // Market closed
+
+class QuoteCache
+{
+public:
+    /// Returns the cache of this process.
+    static QuoteCache &instance();
+
+    /// Looks up a valid quote.
+    /// @param symbol The symbol.
+    /// @param metrics Metrics struct that receives the quote.
+    /// @return True if a valid quote is available.
+    bool get(const std::string &symbol, Metrics &metrics);
+
+    /// Stores a quote; it stays valid for the TTL that belongs to its market state.
+    /// @param symbol The symbol.
+    /// @param metrics The quote.
+    void put(const std::string &symbol, const Metrics &metrics);
+
+    /// Returns the symbols whose quote is missing or expires within the given time.
+    /// @param symbols The symbols to check.
+    /// @param lead How long before expiry a quote counts as expiring.
+    /// @return The symbols that should be fetched again.
+    std::vector<std::string> expiring(const std::vector<std::string> &symbols, std::chrono::seconds lead);
+
+private:
+    struct Entry
+    {
+        Metrics metrics;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    std::unordered_map<std::string, Entry> entries;
+    std::shared_mutex mutex;
+};
+
+#endif // QUOTECACHE_H
@@ -0,0 +1,53 @@
+/// @file quoterefresher.h
+/// @author EtoileScintillante
+/// @brief The following file contains a background refresher that keeps the quotes of all catalog symbols
+///        in the quote cache valid. Quotes are fetched again shortly before they expire, so the cadence follows
+///        the market state (see QuoteCache), and they are fetched in batches of concurrent requests.
+/// @date 2026-10-18
+
+#ifndef QUOTEREFRESHER_H
+#define QUOTEREFRESHER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+constexpr std::chrono::seconds QUOTE_REFRESH_LEAD{5};   // Quotes are fetched again this long before they expire
+constexpr std::chrono::seconds QUOTE_RETRY_DELAY{60};   // Wait before fetching a symbol again that failed
+constexpr std::size_t QUOTE_BATCH_SIZE = 16;            // Maximum number of symbols fetched concurrently
+
+class QuoteRefresher
+{
+public:
+    /// Function that returns the symbols to keep fresh.
+    using SymbolSource = std::function<std::vector<std::string>()>;
+
+    /// Creates the refresher.
+    /// @param symbolSource Function that returns the symbols to keep fresh (called before every round).
+    explicit QuoteRefresher(SymbolSource symbolSource);
+
+    /// Stops the refresher.
+    ~QuoteRefresher();
+
+    QuoteRefresher(const QuoteRefresher &) = delete;
+    QuoteRefresher &operator=(const QuoteRefresher &) = delete;
+
+    /// Starts refreshing on a background thread (one round per second).
+    void start();
+
+    /// Fetches all quotes that are missing or about to expire, on the calling thread.
+    /// @return The number of quotes that were fetched successfully.
+    std::size_t refreshExpiring();
+
+private:
+    SymbolSource symbolSource;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> retryAfter; // Symbols that failed recently
+    std::atomic<bool> stopping{false};
+    std::thread thread;
+};
+
+#endif // QUOTEREFRESHER_H
@@ -0,0 +1,75 @@
+/// @file rendercache.h
+/// @author EtoileScintillante
+/// @brief The following file contains a cache for encoded chart images. An image is stored under the chart
+///        request (symbol, period, mode/volume flag and renderer version) together with the data it was drawn from
+///        (the last bar) and an optional note about the image, and the least recently used images are evicted once the memory budget is exceeded.
+/// @date 2026-10-18
+
+#ifndef RENDERCACHE_H
+#define RENDERCACHE_H
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+constexpr std::size_t RENDER_CACHE_BUDGET = 32 * 1024 * 1024; // Maximum total size of the cached images in bytes
+constexpr std::chrono::seconds RENDER_CACHE_FRESH{60};        // Default time an image is served without fetching the data again
+
+class RenderCache
+{
+public:
+    /// Creates an empty cache.
+    /// @param budget Maximum total size of the cached images in bytes.
+    explicit RenderCache(std::size_t budget);
+
+    /// Returns the most recent image of a request if it is still fresh,
+    /// so that neither the data nor the image has to be created again.
+    /// @param request Key of the chart request (symbol, period, mode/volume flag, renderer version).
+    /// @param image String that receives the encoded image.
+    /// @param note String that receives the note stored with the image, may be nullptr.
+    /// @return True if a fresh image is available.
+    bool getFresh(const std::string &request, std::string &image, std::string *note = nullptr);
+
+    /// Returns the image of a request that was drawn from the given data, and makes it fresh again.
+    /// @param request Key of the chart request.
+    /// @param dataVersion Identifies the data of the chart (e.g. date and close of the last bar).
+    /// @param freshFor How long the image is served by getFresh from now on.
+    /// @param image String that receives the encoded image.
+    /// @param note String that receives the note stored with the image, may be nullptr.
+    /// @return True if the image is cached.
+    bool get(const std::string &request, const std::string &dataVersion, std::chrono::seconds freshFor, std::string &image,
+             std::string *note = nullptr);
+
+    /// Stores an image (and marks it as the most recent image of the request).
+    /// @param request Key of the chart request.
+    /// @param dataVersion Identifies the data of the chart.
+    /// @param freshFor How long the image is served by getFresh.
+    /// @param image The encoded image.
+    /// @param note Text that belongs with the image (e.g. that candles were merged), may be empty.
+    void put(const std::string &request, const std::string &dataVersion, std::chrono::seconds freshFor, const std::string &image,
+             const std::string &note = "");
+
+private:
+    struct Entry
+    {
+        std::string key;
+        std::string request;
+        std::string image;
+        std::string note;
+        std::chrono::steady_clock::time_point freshUntil;
+    };
+
+    // Moves an entry to the front (most recently used) and returns it
+    const Entry &touch(std::list<Entry>::iterator it);
+
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> byKey;
+    std::unordered_map<std::string, std::list<Entry>::iterator> latest; // Most recent image per request
+    std::size_t budget;
+    std::size_t used = 0;
+    std::mutex mutex;
+};
+
+#endif // RENDERCACHE_H
@@ -0,0 +1,62 @@
+/// @file responsecache.h
+/// @author EtoileScintillante
+/// @brief The following file contains a cache for the fully formatted replies of commands without options
+///        (such as /commodities, /currencies and /crypto). A reply is kept for a short window that depends on
+///        the market state, and is rebuilt in the background before that window ends.
+/// @date 2026-10-18
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+// How long a reply stays valid, and how long before expiry the background refresh starts
+constexpr std::chrono::seconds RESPONSE_TTL_OPEN{30};     // At least one market of the reply is open
+constexpr std::chrono::seconds RESPONSE_TTL_CLOSED{300};  // All markets of the reply are closed
+constexpr std::chrono::seconds RESPONSE_REFRESH_LEAD{10}; // Refresh this long before an entry expires
+
+class ResponseCache
+{
+public:
+    /// Function that builds a reply. It sets marketOpen to true if any of the markets in the reply is open,
+    /// and complete to false if part of the data could not be fetched (e.g. during an upstream outage).
+    /// Incomplete replies are returned to the caller but never cached.
+    using Builder = std::function<std::string(bool &marketOpen, bool &complete)>;
+
+    /// Registers a command whose reply should be cached.
+    /// @param command Name of the command.
+    /// @param builder Function that creates the formatted reply.
+    void add(const std::string &command, Builder builder);
+
+    /// Returns the reply of a command. Only when there is no valid reply yet (e.g. right after startup, or after
+    /// a rebuild came back incomplete), the reply is built on the calling thread.
+    /// @param command Name of the command.
+    /// @param reply String that receives the reply.
+    /// @return False if the command is not registered.
+    bool get(const std::string &command, std::string &reply);
+
+    /// Starts a background rebuild for every reply that is missing or about to expire.
+    /// Should be called periodically (e.g. from a timer), with an interval shorter than RESPONSE_REFRESH_LEAD.
+    void refreshExpiring();
+
+private:
+    struct Entry
+    {
+        Builder builder;
+        std::string reply;
+        std::chrono::steady_clock::time_point expires{};
+        bool refreshing = false;
+    };
+
+    // Builds the reply of a command and stores it if it is complete; returns the reply
+    std::string rebuild(const std::string &command);
+
+    std::map<std::string, Entry> entries;
+    std::mutex mutex;
+};
+
+#endif // RESPONSECACHE_H
@@ -0,0 +1,120 @@
+/// @file sharedcache.h
+/// @author EtoileScintillante
+/// @brief The following file contains a quote and OHLC cache that lives in POSIX shared memory.
+///        When several bot processes run on the same host (each owning a range of shards),
+///        they all attach to the same cache, so an upstream fetch done by one process
+///        serves every other process as well. Entries are protected by seqlocks:
+///        readers never block, writers claim an entry with a single compare-and-swap.
+/// @date 2026-10-18
+
+#ifndef SHAREDCACHE_H
+#define SHAREDCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include "data.h"
+
+// Number of entries in the shared cache and size of a single OHLC entry
+constexpr std::size_t SHARED_QUOTE_SLOTS = 1024;           // Quotes (Metrics) of individual symbols
+constexpr std::size_t SHARED_OHLC_SLOTS = 64;              // Raw CSV responses of historical data requests
+constexpr std::size_t SHARED_OHLC_CAPACITY = 256 * 1024;   // Enough for roughly 10 years of daily data
+constexpr std::size_t SHARED_PROBE_LENGTH = 4;             // Number of neighbouring slots searched for a key
+
+// Freshness of the cached data (in seconds)
+constexpr std::time_t SHARED_QUOTE_TTL_OPEN = 15;    // Quote of an equity whose market is open
+constexpr std::time_t SHARED_QUOTE_TTL_CLOSED = 120; // Quote of an equity whose market is closed
+constexpr std::time_t SHARED_OHLC_TTL = 300;         // Daily OHLC data
+
+// Entry with the quote (Metrics) of a single symbol
+// Strings are stored in fixed size buffers, so the entry can be placed in shared memory
+struct SharedQuoteEntry
+{
+    std::atomic<std::uint32_t> seq;     // Seqlock sequence number (odd while an entry is being written)
+    std::atomic<std::int64_t> lockedAt; // Time at which the current writer claimed the entry
+    std::int64_t updated;               // Time at which the entry was last filled
+    char key[32];                       // Normalized (upper case) symbol
+    char name[128];
+    char currency[16];
+    char symbol[32];
+    char marketState[16];
+    double marketCap;
+    double peRatio;
+    double latestPrice;
+    double latestChange;
+    double openPrice;
+    double dayLow;
+    double dayHigh;
+    double prevClose;
+    double fiftyTwoWeekLow;
+    double fiftyTwoWeekHigh;
+    double avg_50;
+    double avg_200;
+    double avgVol_3mo;
+};
+
+// Entry with the raw CSV response of a historical data request
+struct SharedOHLCEntry
+{
+    std::atomic<std::uint32_t> seq;     // Seqlock sequence number (odd while an entry is being written)
+    std::atomic<std::int64_t> lockedAt; // Time at which the current writer claimed the entry
+    std::int64_t updated;               // Time at which the entry was last filled
+    char key[48];                       // Normalized symbol + duration in seconds
+    std::uint32_t length;               // Number of bytes used in csv
+    char csv[SHARED_OHLC_CAPACITY];
+};
+
+// Layout of the shared memory region
+struct SharedRegion
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    SharedQuoteEntry quotes[SHARED_QUOTE_SLOTS];
+    SharedOHLCEntry ohlc[SHARED_OHLC_SLOTS];
+};
+
+class SharedCache
+{
+public:
+    /// Creates (or opens) the shared memory object and maps it into this process.
+    /// After a successful call, instance() returns the cache and the data functions start using it.
+    /// @param name Name of the POSIX shared memory object (e.g. "/equity-bot-cache").
+    /// @return True if the cache could be attached, false otherwise.
+    static bool attach(const std::string &name);
+
+    /// Returns the attached cache, or a nullptr if this process did not attach to a cache.
+    static SharedCache *instance();
+
+    /// Looks up a fresh quote of a symbol.
+    /// @param symbol The symbol of the stock/future/index/crypto.
+    /// @param metrics Metrics struct that is filled when a fresh entry was found.
+    /// @return True on a hit, false if there is no (fresh) entry.
+    bool readQuote(const std::string &symbol, Metrics &metrics);
+
+    /// Stores the quote of a symbol. If another process is writing the same entry, nothing happens.
+    /// @param symbol The symbol that was requested (used as key).
+    /// @param metrics The fetched metrics.
+    void writeQuote(const std::string &symbol, const Metrics &metrics);
+
+    /// Looks up the raw CSV response of a fresh historical data request.
+    /// @param symbol The symbol of the stock/future/index/crypto.
+    /// @param duration The duration in seconds.
+    /// @param csv String that receives the CSV data on a hit.
+    /// @return True on a hit, false if there is no (fresh) entry.
+    bool readOHLC(const std::string &symbol, std::time_t duration, std::string &csv);
+
+    /// Stores the raw CSV response of a historical data request.
+    /// Responses that do not fit in an entry are not cached.
+    /// @param symbol The symbol of the stock/future/index/crypto.
+    /// @param duration The duration in seconds.
+    /// @param csv The CSV response.
+    void writeOHLC(const std::string &symbol, std::time_t duration, const std::string &csv);
+
+private:
+    explicit SharedCache(SharedRegion *region);
+
+    SharedRegion *region;
+};
+
+#endif // SHAREDCACHE_H
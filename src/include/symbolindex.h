@@ -0,0 +1,115 @@
+/// @file symbolindex.h
+/// @author EtoileScintillante
+/// @brief The following file contains the in-memory index behind symbol autocompletion.
+///        It holds the symbols and names of the catalog plus every symbol for which a quote was fetched,
+///        in sorted arrays of lowercase keys, so a prefix lookup is a binary search followed by a short scan
+///        (a few microseconds, far within Discord's autocomplete time limit).
+///        Names can also be searched fuzzily (e.g. "volkswagn") through an inverted index of their trigrams
+///        (sequences of three characters), which is extended whenever a symbol is added.
+/// @date 2026-10-18
+
+#ifndef SYMBOLINDEX_H
+#define SYMBOLINDEX_H
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Catalog;
+
+// Maximum number of suggestions (Discord shows at most 25 autocomplete choices)
+constexpr size_t AUTOCOMPLETE_LIMIT = 25;
+
+// A suggestion of the index
+struct SymbolMatch
+{
+    std::string symbol; // Symbol (e.g. "AAPL")
+    std::string name;   // Name (e.g. "Apple Inc."), may be empty
+};
+
+// Maximum number of results of /search
+constexpr size_t SEARCH_LIMIT = 10;
+
+// Minimum score of a name match for resolve to replace the typed text by its symbol
+constexpr double RESOLVE_MIN_SCORE = 0.8;
+
+// Minimum length of the text that resolve looks up by name (shorter text is treated as a ticker)
+constexpr size_t RESOLVE_MIN_LENGTH = 4;
+
+// A result of a fuzzy name search
+struct SearchResult
+{
+    SymbolMatch match;
+    double score; // Between 0 and 1; 1 means every trigram of the query occurs in the name
+};
+
+class SymbolIndex
+{
+public:
+    /// Returns the index of this process.
+    static SymbolIndex &instance();
+
+    /// Adds a symbol. Known symbols are ignored, unless they had no name yet.
+    /// @param symbol The symbol.
+    /// @param name The name of the equity (may be empty).
+    void add(const std::string &symbol, const std::string &name);
+
+    /// Adds all symbols and names of a catalog.
+    /// @param catalog The catalog.
+    void addCatalog(const Catalog &catalog);
+
+    /// Finds the symbols that start with the given text, followed by the symbols of which a word of the name
+    /// starts with it (case insensitive). Symbols are returned in alphabetical order, each at most once.
+    /// @param prefix The text typed so far.
+    /// @param limit Maximum number of matches.
+    /// @return The matches.
+    std::vector<SymbolMatch> lookup(std::string_view prefix, size_t limit = AUTOCOMPLETE_LIMIT) const;
+
+    /// Searches the names with the trigrams of the query, which tolerates typos and partial names.
+    /// The score of a name is mostly the share of the query trigrams it contains; the share of its own trigrams
+    /// that match the query decides between names that contain the query equally well (shorter names rank higher).
+    /// @param query The (part of the) name to look for.
+    /// @param limit Maximum number of results.
+    /// @return The results, best match first.
+    std::vector<SearchResult> search(std::string_view query, size_t limit = SEARCH_LIMIT) const;
+
+    /// Turns what a user typed into a symbol: a known symbol (in any case) is returned as it is known.
+    /// Text that looks like a name (at least RESOLVE_MIN_LENGTH characters, with a lowercase letter or a space)
+    /// is replaced by the symbol of the best name match, if its score is at least RESOLVE_MIN_SCORE.
+    /// Anything else is returned unchanged, so tickers that are not in the index (e.g. "T" or "GOLD") are
+    /// fetched as typed instead of being taken for a similar name.
+    /// @param text The symbol or name.
+    /// @return The symbol.
+    std::string resolve(const std::string &text) const;
+
+    /// Returns the number of symbols in the index.
+    size_t size() const;
+
+private:
+    // A lowercase search key (a symbol, or a name from one of its words on) and the entry it belongs to
+    struct Key
+    {
+        std::string text;
+        uint32_t entry;
+    };
+
+    // Inserts a key in a sorted array of keys
+    static void insertKey(std::vector<Key> &keys, std::string text, uint32_t entry);
+
+    // Adds the keys and trigrams of a name (must hold the lock)
+    void addNameKeys(const std::string &name, uint32_t entry);
+
+    std::vector<SymbolMatch> entries;
+    std::unordered_map<std::string, uint32_t> bySymbol;
+    std::unordered_map<std::string, uint32_t> byLowercaseSymbol;
+    std::vector<Key> symbolKeys; // Sorted by text
+    std::vector<Key> nameKeys;   // Sorted by text
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams; // Trigram -> entries whose name contains it
+    std::vector<uint16_t> trigramCounts;                          // Number of distinct trigrams of the name of every entry
+    mutable std::shared_mutex mutex;
+};
+
+#endif // SYMBOLINDEX_H
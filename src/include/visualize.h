@@ -7,9 +7,103 @@
 #define VISUALIZE_H
 
 #include "data.h"
+#include "gnuplotpool.h"
+#include <chrono>
 #include <matplot/matplot.h>
 
-/// Plots Open and Close prices and saves the graph as price_graph.png in the folder 'images'.
+// Available ways to draw the charts
+enum class ChartRenderer
+{
+    Matplot, // Matplot++ with a pool of gnuplot processes
+    Native   // Built-in rasterizer and PNG encoder (default)
+};
+
+// Available image formats of the charts
+enum class ImageFormat
+{
+    PNG,        // 24-bit RGB PNG
+    PalettePNG, // Palette-indexed PNG with at most 256 colors (default, native renderer only)
+    SVG         // Vector graphics
+};
+
+// How the charts are encoded
+struct ImageOptions
+{
+    ImageFormat format = ImageFormat::PalettePNG;
+    int compressionLevel = 9; // zlib compression level of PNG images (0 = fastest, 9 = smallest)
+};
+
+// Parsed daily OHLCV data of a single symbol, ready to be plotted
+struct ChartData
+{
+    std::string currency = "-";     // Currency of the prices
+    std::vector<std::string> dates; // Dates in format y/m/d
+    std::vector<double> open;       // Opening prices
+    std::vector<double> high;       // Highest prices
+    std::vector<double> low;        // Lowest prices
+    std::vector<double> close;      // Closing prices
+    std::vector<double> volume;     // Volumes (0 if not available)
+};
+
+/// Sets the renderer used by priceGraph and createCandleChart.
+/// @param renderer The renderer.
+void setChartRenderer(ChartRenderer renderer);
+
+/// Returns the renderer used by priceGraph and createCandleChart.
+ChartRenderer getChartRenderer();
+
+/// Sets the image format used by priceGraph and createCandleChart.
+/// The Matplot++ renderer writes regular PNG images when a palette PNG is requested.
+/// @param options The image format and compression level.
+void setImageOptions(ImageOptions options);
+
+/// Returns the image format used by priceGraph and createCandleChart.
+ImageOptions getImageOptions();
+
+/// Returns the file extension of an image format (e.g. "png").
+/// @param format The image format.
+std::string imageFileExtension(ImageFormat format);
+
+/// Returns the MIME type of an image format (e.g. "image/png").
+/// @param format The image format.
+std::string imageMimeType(ImageFormat format);
+
+/// Returns the utilization of the gnuplot processes used by the Matplot++ renderer.
+GnuplotPoolStats getGnuplotPoolStats();
+
+/// Fetches the OHLCV data (and currency) of a symbol and converts it to numbers.
+/// @param symbol The symbol of the stock/future/index/crypto.
+/// @param duration The duration/period in the format: 1y, 6mo, 2w, 12d, etc.
+/// @param chartData ChartData struct that receives the data.
+/// @return True if data is available, false otherwise.
+bool loadChartData(const std::string &symbol, const std::string &duration, ChartData &chartData);
+
+/// Selects the dates that are shown on the x-axis: every date for periods up to 20 days,
+/// otherwise about 10 evenly spaced dates.
+/// @param dates All dates of the chart.
+/// @param xTicks Vector that receives the positions (indices) of the selected dates.
+/// @param xtickLabels Vector that receives the selected dates.
+void getDateTicks(const std::vector<std::string> &dates, std::vector<double> &xTicks, std::vector<std::string> &xtickLabels);
+
+/// Draws the price graph (see priceGraph) for data that has already been fetched.
+/// @param data The OHLC data.
+/// @param mode An integer representing the display mode (1, 2, or 3).
+/// @param renderer The renderer to use.
+/// @param options The image format.
+/// @return The encoded image, or an empty string if the graph could not be created.
+std::string renderPriceGraph(const ChartData &data, int mode, ChartRenderer renderer, ImageOptions options = ImageOptions());
+
+/// Draws the candlestick chart (see createCandleChart) for data that has already been fetched.
+/// @param data The OHLCV data.
+/// @param withVolume Set to true if you want to plot volumes as well.
+/// @param renderer The renderer to use.
+/// @param options The image format.
+/// @param merged Set to true if consecutive days were merged into one candle, may be nullptr.
+/// @return The encoded image, or an empty string if the chart could not be created.
+std::string renderCandleChart(const ChartData &data, bool withVolume, ChartRenderer renderer, ImageOptions options = ImageOptions(),
+                              bool *merged = nullptr);
+
+/// Plots Open and Close prices and returns the graph as a PNG image.
 /// This function fetches OHLC (Open-High-Low-Close) data and plots the opening
 /// and/or closing prices over time. It provides three display modes:
 /// - Mode 1: Display only the open prices.
@@ -19,18 +113,48 @@
 /// @param duration The duration/period in the format: 1y, 6mo, 2w, 12d, etc.
 /// @param mode An integer representing the display mode (1, 2, or 3).
 ///             Any other value will result in an error message and no plot.
-void priceGraph(std::string symbol, std::string duration, int mode);
+/// @return The encoded image (see setImageOptions), or an empty string if the graph could not be created.
+/// @note Lines with more points than the chart is wide in pixels are downsampled (see downsampleLTTB),
+///       so the render time does not grow with the length of the period.
+/// @note The function returns once the image is completely rendered. Every call renders in its own
+///       figure (or canvas), so the function can be called from several threads at the same time.
+/// @note Images are cached (see RenderCache): a repeated request within RENDER_CACHE_FRESH is answered
+///       without fetching data, and a chart is only drawn again when its last bar has changed.
+std::string priceGraph(std::string symbol, std::string duration, int mode);
 
-/// Plots OHLC(V) data and saves the candlestick chart as candle_chart.png in the folder 'images'.
+/// Plots OHLC(V) data and returns the candlestick chart as a PNG image.
 /// This function fetches OHLCV (Open-High-Low-Close-Volume) data and creates a candlestick chart,
 /// optionally with the volume bars plotted at the bottom. The interval of the data is one day.
 /// @param symbol The symbol of the stock/future/index/crypto.
 /// @param duration The duration/period in the format: 1y, 6mo, 2w, 12d, etc.
 /// @param withVolume Set to true if you want to plot volumes as well.
-/// @note Please note that using OHLCV data of a period >12 months may lead
-///       to a candlestick chart and volume graph that are not clearly readable. In such cases, the candlesticks
-///       and volume bars may appear very thin or small, making it hard to discern the details.
-void createCandleChart(std::string symbol, std::string duration, bool withVolume = false);
+/// @param note String that receives a note for the user about the chart (e.g. that candles were merged),
+///             or an empty string; may be nullptr.
+/// @return The encoded image (see setImageOptions), or an empty string if the chart could not be created.
+/// @note The function returns once the image is completely rendered. Every call renders in its own
+///       figure (or canvas), so the function can be called from several threads at the same time.
+/// @note Images are cached (see RenderCache): a repeated request within RENDER_CACHE_FRESH is answered
+///       without fetching data, and a chart is only drawn again when its last bar has changed.
+/// @note If the period has more days than fit next to each other in the chart (MIN_CANDLE_PITCH),
+///       consecutive days are merged, so that every candlestick and volume bar covers several days.
+std::string createCandleChart(std::string symbol, std::string duration, bool withVolume = false, std::string *note = nullptr);
+
 
+/// Draws a price graph ahead of time (fetching the latest data) and stores it in the render cache,
+/// so that priceGraph calls with the same arguments return it immediately during freshFor.
+/// @param symbol The symbol of the stock/future/index/crypto.
+/// @param duration The duration/period in the format: 1y, 6mo, 2w, 12d, etc.
+/// @param mode An integer representing the display mode (1, 2, or 3).
+/// @param freshFor How long the graph is served without fetching the data again.
+/// @return True if the graph was created (or was already up to date).
+bool prerenderPriceGraph(const std::string &symbol, const std::string &duration, int mode, std::chrono::seconds freshFor);
+
+/// Draws a candlestick chart ahead of time and stores it in the render cache (see prerenderPriceGraph).
+/// @param symbol The symbol of the stock/future/index/crypto.
+/// @param duration The duration/period in the format: 1y, 6mo, 2w, 12d, etc.
+/// @param withVolume Set to true if you want to plot volumes as well.
+/// @param freshFor How long the chart is served without fetching the data again.
+/// @return True if the chart was created (or was already up to date).
+bool prerenderCandleChart(const std::string &symbol, const std::string &duration, bool withVolume, std::chrono::seconds freshFor);
 
 #endif // VISUALIZE_H
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "nativechart.h"
+#include "canvas.h"
+#include "downsample.h"
+#include <cmath>
+#include <cstdio>
+
+// Size of the charts (same as the Matplot++ figures)
+static const int CHART_WIDTH = 900;
+static const int CHART_HEIGHT = 600;
+
+// Colors matching the Matplot++ (gnuplot) look
+static const Color WHITE{255, 255, 255, 255};
+static const Color BLACK{0, 0, 0, 255};
+static const Color BLUE{0, 0, 255, 255};
+static const Color AXIS_COLOR{38, 38, 38, 255};
+static const Color Y_AXIS_COLOR{0, 114, 189, 255};   // Left axis labels when a second y-axis is shown
+static const Color Y2_AXIS_COLOR{217, 83, 25, 255};  // Right axis labels
+static const Color CANDLE_GREEN{102, 230, 76, 255};
+static const Color CANDLE_RED{238, 68, 51, 255};
+static const Color VOLUME_GREEN{102, 230, 76, 77};   // 30% opacity
+static const Color VOLUME_RED{238, 68, 51, 77};      // 30% opacity
+
+// Area of the canvas inside the axes, and the data ranges mapped onto it
+struct PlotArea
+{
+    double left = 105;
+    double right = CHART_WIDTH - 60;
+    double top = 35;
+    double bottom = CHART_HEIGHT - 80;
+    double xMin = 0, xMax = 1;
+    double yMin = 0, yMax = 1;
+    double y2Min = 0, y2Max = 1;
+
+    double px(double x) const { return left + (x - xMin) / (xMax - xMin) * (right - left); }
+    double py(double y) const { return bottom - (y - yMin) / (yMax - yMin) * (bottom - top); }
+    double py2(double y) const { return bottom - (y - y2Min) / (y2Max - y2Min) * (bottom - top); }
+};
+
+// Returns a "nice" tick step (1, 2 or 5 times a power of 10) that gives about targetTicks ticks
+static double niceStep(double range, int targetTicks)
+{
+    if (range <= 0)
+    {
+        return 1;
+    }
+    double rough = range / targetTicks;
+    double magnitude = std::pow(10.0, std::floor(std::log10(rough)));
+    double fraction = rough / magnitude;
+    double nice = (fraction < 1.5) ? 1 : (fraction < 3) ? 2 : (fraction < 7) ? 5 : 10;
+    return nice * magnitude;
+}
+
+// Creates the canvas of a chart (recording the drawing operations if the chart is saved as SVG)
+static Canvas createCanvas(const ImageOptions &options)
+{
+    Canvas canvas(CHART_WIDTH, CHART_HEIGHT, WHITE);
+    if (options.format == ImageFormat::SVG)
+    {
+        canvas.recordSVG();
+    }
+    return canvas;
+}
+
+// Encodes a finished chart in the requested format
+static std::string encode(const Canvas &canvas, const ImageOptions &options)
+{
+    switch (options.format)
+    {
+    case ImageFormat::SVG:
+        return canvas.encodeSVG();
+    case ImageFormat::PalettePNG:
+        return canvas.encodePalettePNG(options.compressionLevel);
+    default:
+        return canvas.encodePNG(options.compressionLevel);
+    }
+}
+
+// Returns all multiples of step between min and max
+static std::vector<double> ticksBetween(double min, double max, double step)
+{
+    std::vector<double> ticks;
+    for (double tick = std::ceil(min / step - 1e-9) * step; tick <= max + step * 1e-9; tick += step)
+    {
+        ticks.push_back(std::abs(tick) < step * 1e-9 ? 0 : tick);
+    }
+    return ticks;
+}
+
+// Formats a tick value with just enough decimals for the step size
+static std::string formatTick(double value, double step)
+{
+    int decimals = std::max(0, static_cast<int>(std::ceil(-std::log10(step) - 1e-9)));
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    return buffer;
+}
+
+// Draws ticks and labels of the x-axis (dates, rotated like xtickangle(35)) and of the left y-axis
+static void drawAxes(Canvas &canvas, const PlotArea &area, const ChartData &data, const std::string &ylabel, Color yTickColor)
+{
+    // Dates
+    std::vector<double> xTicks;
+    std::vector<std::string> xtickLabels;
+    getDateTicks(data.dates, xTicks, xtickLabels);
+    for (size_t i = 0; i < xTicks.size(); i++)
+    {
+        double x = area.px(xTicks[i]);
+        canvas.drawLine(x, area.bottom, x, area.bottom - 5, 1, AXIS_COLOR);
+        canvas.drawText(xtickLabels[i], x, area.bottom + 12, AXIS_COLOR, 1, 35);
+    }
+
+    // Prices
+    double step = niceStep(area.yMax - area.yMin, 8);
+    for (double tick : ticksBetween(area.yMin, area.yMax, step))
+    {
+        double y = area.py(tick);
+        canvas.drawLine(area.left, y, area.left + 5, y, 1, AXIS_COLOR);
+        canvas.drawText(formatTick(tick, step), area.left - 8, y, yTickColor, 1);
+    }
+    canvas.drawText(ylabel, area.left - 60, (area.top + area.bottom) / 2, BLACK, 0.5, 90);
+}
+
+// Draws the box around the plot area
+static void drawBorder(Canvas &canvas, const PlotArea &area)
+{
+    canvas.fillRect(area.left - 0.5, area.top - 0.5, area.right + 0.5, area.top + 0.5, AXIS_COLOR);
+    canvas.fillRect(area.left - 0.5, area.bottom - 0.5, area.right + 0.5, area.bottom + 0.5, AXIS_COLOR);
+    canvas.fillRect(area.left - 0.5, area.top - 0.5, area.left + 0.5, area.bottom + 0.5, AXIS_COLOR);
+    canvas.fillRect(area.right - 0.5, area.top - 0.5, area.right + 0.5, area.bottom + 0.5, AXIS_COLOR);
+}
+
+std::string nativePriceGraph(const ChartData &data, int mode, ImageOptions options)
+{
+    Canvas canvas = createCanvas(options);
+    size_t count = data.dates.size();
+    bool showOpen = (mode == 1 || mode == 3);
+    bool showClose = (mode == 2 || mode == 3);
+
+    // Like gnuplot's autoscale, the y-range is extended to whole ticks
+    double lowest = 1e300, highest = -1e300;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (showOpen)
+        {
+            lowest = std::min(lowest, data.open[i]);
+            highest = std::max(highest, data.open[i]);
+        }
+        if (showClose)
+        {
+            lowest = std::min(lowest, data.close[i]);
+            highest = std::max(highest, data.close[i]);
+        }
+    }
+    double step = niceStep(highest - lowest, 8);
+    PlotArea area;
+    area.xMin = -1;
+    area.xMax = static_cast<double>(count); // Small offset from edges, so the line(s) do not cross the axis
+    area.yMin = std::floor(lowest / step) * step;
+    area.yMax = std::ceil(highest / step) * step;
+    if (area.yMax <= area.yMin)
+    {
+        area.yMin -= step;
+        area.yMax += step;
+    }
+
+    // Price lines, reduced to at most one point per pixel column
+    size_t maxPoints = static_cast<size_t>(area.right - area.left);
+    auto drawPrices = [&](const std::vector<double> &prices, Color color)
+    {
+        std::vector<double> xs, ys;
+        downsampleLTTB(prices, maxPoints, xs, ys);
+        for (size_t i = 0; i < xs.size(); i++)
+        {
+            xs[i] = area.px(xs[i]);
+            ys[i] = area.py(ys[i]);
+        }
+        canvas.drawPolyline(xs, ys, 2, color);
+    };
+    if (showOpen)
+    {
+        drawPrices(data.open, BLUE);
+    }
+    if (showClose)
+    {
+        drawPrices(data.close, BLACK);
+    }
+
+    drawAxes(canvas, area, data, "Price in " + data.currency, AXIS_COLOR);
+
+    // Legend in the top right corner: line sample followed by the name
+    std::vector<std::pair<std::string, Color>> entries;
+    if (showOpen)
+    {
+        entries.push_back({"Open", BLUE});
+    }
+    if (showClose)
+    {
+        entries.push_back({"Close", BLACK});
+    }
+    double boxRight = area.right - 8, boxTop = area.top + 8;
+    double boxLeft = boxRight - 120, boxBottom = boxTop + 6 + 16 * entries.size();
+    canvas.fillRect(boxLeft, boxTop, boxRight, boxBottom, WHITE);
+    canvas.fillRect(boxLeft - 0.5, boxTop - 0.5, boxRight + 0.5, boxTop + 0.5, AXIS_COLOR);
+    canvas.fillRect(boxLeft - 0.5, boxBottom - 0.5, boxRight + 0.5, boxBottom + 0.5, AXIS_COLOR);
+    canvas.fillRect(boxLeft - 0.5, boxTop - 0.5, boxLeft + 0.5, boxBottom + 0.5, AXIS_COLOR);
+    canvas.fillRect(boxRight - 0.5, boxTop - 0.5, boxRight + 0.5, boxBottom + 0.5, AXIS_COLOR);
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        double y = boxTop + 11 + 16 * i;
+        canvas.drawLine(boxLeft + 8, y, boxLeft + 50, y, 2, entries[i].second);
+        canvas.drawText(entries[i].first, boxLeft + 58, y, BLACK);
+    }
+
+    drawBorder(canvas, area);
+    return encode(canvas, options);
+}
+
+std::string nativeCandleChart(const ChartData &fullData, bool withVolume, ImageOptions options, bool *merged)
+{
+    Canvas canvas = createCanvas(options);
+    PlotArea area;
+
+    // Merge days into longer candles if the plot is too narrow to show every day
+    ChartData data = downsampleCandles(fullData, static_cast<size_t>((area.right - area.left) / MIN_CANDLE_PITCH));
+    size_t count = data.dates.size();
+    if (merged)
+    {
+        *merged = (count < fullData.dates.size());
+    }
+
+    area.xMin = -1;
+    area.xMax = static_cast<double>(count); // Small offset so the first and last candles are not in the axis
+    area.yMin = *std::min_element(data.low.begin(), data.low.end()) * 0.99;
+    area.yMax = *std::max_element(data.high.begin(), data.high.end()) * 1.01;
+
+    // Volume bars (in 10^7) at the bottom; the y2 limit is 4 times the highest volume,
+    // so the bars do not overlay the candlesticks too much
+    if (withVolume)
+    {
+        double highestVolume = *std::max_element(data.volume.begin(), data.volume.end()) / 10000000;
+        area.y2Min = 0;
+        area.y2Max = (highestVolume > 0) ? highestVolume * 4 : 1;
+        for (size_t i = 0; i < count; i++)
+        {
+            Color color = (data.close[i] >= data.open[i]) ? VOLUME_GREEN : VOLUME_RED;
+            canvas.fillRect(area.px(i - 0.2), area.py2(data.volume[i] / 10000000), area.px(i + 0.2), area.bottom, color);
+        }
+    }
+
+    // Candlesticks: wick from high to low, body between open and close (at least one pixel high)
+    for (size_t i = 0; i < count; i++)
+    {
+        double x = area.px(static_cast<double>(i));
+        canvas.drawLine(x, area.py(data.high[i]), x, area.py(data.low[i]), 1.2, BLACK);
+
+        double top = area.py(std::max(data.open[i], data.close[i]));
+        double bottom = area.py(std::min(data.open[i], data.close[i]));
+        if (bottom - top < 1)
+        {
+            top = (top + bottom) / 2 - 0.5;
+            bottom = top + 1;
+        }
+        Color color = (data.close[i] >= data.open[i]) ? CANDLE_GREEN : CANDLE_RED;
+        canvas.fillRect(area.px(i - 0.2), top, area.px(i + 0.2), bottom, color);
+    }
+
+    drawAxes(canvas, area, data, "Price in " + data.currency, withVolume ? Y_AXIS_COLOR : AXIS_COLOR);
+
+    // Second y-axis for the volumes
+    if (withVolume)
+    {
+        double step = niceStep(area.y2Max - area.y2Min, 8);
+        for (double tick : ticksBetween(area.y2Min, area.y2Max, step))
+        {
+            double y = area.py2(tick);
+            canvas.drawLine(area.right, y, area.right - 5, y, 1, AXIS_COLOR);
+            canvas.drawText(formatTick(tick, step), area.right + 8, y, Y2_AXIS_COLOR);
+        }
+        canvas.drawText("Volume (in 10^7)", area.right + 45, (area.top + area.bottom) / 2, BLACK, 0.5, 90);
+    }
+
+    drawBorder(canvas, area);
+    return encode(canvas, options);
+}
@@ -0,0 +1,55 @@
+#include "progressivereply.h"
+
+ProgressiveReply::ProgressiveReply(const dpp::slashcommand_t &event) : state(std::make_shared<State>(event))
+{
+    // Edits of the original response only work once Discord has processed the deferred reply;
+    // the text that arrived in the meantime is shown then
+    std::shared_ptr<State> shared = state;
+    event.thinking(false, [shared](const dpp::confirmation_callback_t &callback)
+                   {
+                       if (callback.is_error())
+                       {
+                           std::cerr << "Deferred reply failed: " << callback.get_error().message << std::endl;
+                       }
+                       std::lock_guard<std::mutex> lock(shared->mutex);
+                       shared->acknowledged = true;
+                       if (!shared->pending.empty())
+                       {
+                           shared->edit(shared->pending);
+                       }
+                   });
+}
+
+void ProgressiveReply::update(const std::string &content)
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->finished)
+    {
+        return;
+    }
+    if (!state->acknowledged || std::chrono::steady_clock::now() - state->lastEdit < REPLY_EDIT_INTERVAL)
+    {
+        state->pending = content; // Shown by the acknowledgement, or replaced by a newer update or finish
+        return;
+    }
+    state->edit(content);
+}
+
+void ProgressiveReply::finish(const std::string &content)
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->finished = true;
+    if (!state->acknowledged)
+    {
+        state->pending = content;
+        return;
+    }
+    state->edit(content);
+}
+
+void ProgressiveReply::State::edit(const std::string &content)
+{
+    lastEdit = std::chrono::steady_clock::now();
+    pending.clear();
+    event.edit_original_response(dpp::message(content));
+}
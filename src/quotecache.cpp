@@ -0,0 +1,52 @@
+#include "quotecache.h"
+#include <mutex>
+
+QuoteCache &QuoteCache::instance()
+{
+    static QuoteCache cache;
+    return cache;
+}
+
+bool QuoteCache::get(const std::string &symbol, Metrics &metrics)
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = entries.find(symbol);
+    if (it == entries.end() || std::chrono::steady_clock::now() >= it->second.expires)
+    {
+        return false;
+    }
+    metrics = it->second.metrics;
+    return true;
+}
+
+void QuoteCache::put(const std::string &symbol, const Metrics &metrics)
+{
+    std::chrono::seconds ttl = QUOTE_TTL_CLOSED;
+    if (metrics.marketState == "REGULAR")
+    {
+        ttl = QUOTE_TTL_OPEN;
+    }
+    else if (metrics.marketState == "PRE" || metrics.marketState == "POST")
+    {
+        ttl = QUOTE_TTL_EXTENDED;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    entries[symbol] = Entry{metrics, std::chrono::steady_clock::now() + ttl};
+}
+
+std::vector<std::string> QuoteCache::expiring(const std::vector<std::string> &symbols, std::chrono::seconds lead)
+{
+    std::vector<std::string> result;
+    auto refreshAt = std::chrono::steady_clock::now() + lead;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (const std::string &symbol : symbols)
+    {
+        auto it = entries.find(symbol);
+        if (it == entries.end() || it->second.expires <= refreshAt)
+        {
+            result.push_back(symbol);
+        }
+    }
+    return result;
+}
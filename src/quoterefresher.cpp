@@ -0,0 +1,65 @@
+#include "quoterefresher.h"
+#include "data.h"
+#include "quotecache.h"
+#include <algorithm>
+
+QuoteRefresher::QuoteRefresher(SymbolSource symbolSource) : symbolSource(std::move(symbolSource))
+{
+}
+
+QuoteRefresher::~QuoteRefresher()
+{
+    stopping = true;
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+void QuoteRefresher::start()
+{
+    if (thread.joinable())
+    {
+        return;
+    }
+    thread = std::thread([this]()
+                         {
+                             while (!stopping)
+                             {
+                                 refreshExpiring();
+                                 std::this_thread::sleep_for(std::chrono::seconds(1));
+                             } });
+}
+
+std::size_t QuoteRefresher::refreshExpiring()
+{
+    // Symbols that failed recently are skipped until their retry time
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::string> due;
+    for (const std::string &symbol : QuoteCache::instance().expiring(symbolSource(), QUOTE_REFRESH_LEAD))
+    {
+        auto failed = retryAfter.find(symbol);
+        if (failed == retryAfter.end() || failed->second <= now)
+        {
+            due.push_back(symbol);
+        }
+    }
+
+    std::size_t fetched = 0;
+    for (std::size_t start = 0; start < due.size() && !stopping; start += QUOTE_BATCH_SIZE)
+    {
+        std::vector<std::string> batch(due.begin() + start, due.begin() + std::min(start + QUOTE_BATCH_SIZE, due.size()));
+        std::vector<Metrics> results = fetchMetricsBatch(batch);
+        for (std::size_t i = 0; i < batch.size(); i++)
+        {
+            if (results[i].symbol == "-")
+            {
+                retryAfter[batch[i]] = std::chrono::steady_clock::now() + QUOTE_RETRY_DELAY;
+                continue;
+            }
+            retryAfter.erase(batch[i]);
+            fetched++;
+        }
+    }
+    return fetched;
+}
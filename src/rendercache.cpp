@@ -0,0 +1,88 @@
+#include "rendercache.h"
+
+RenderCache::RenderCache(std::size_t budget) : budget(budget)
+{
+}
+
+const RenderCache::Entry &RenderCache::touch(std::list<Entry>::iterator it)
+{
+    entries.splice(entries.begin(), entries, it);
+    return *it;
+}
+
+bool RenderCache::getFresh(const std::string &request, std::string &image, std::string *note)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = latest.find(request);
+    if (it == latest.end() || std::chrono::steady_clock::now() >= it->second->freshUntil)
+    {
+        return false;
+    }
+    const Entry &entry = touch(it->second);
+    image = entry.image;
+    if (note)
+    {
+        *note = entry.note;
+    }
+    return true;
+}
+
+bool RenderCache::get(const std::string &request, const std::string &dataVersion, std::chrono::seconds freshFor, std::string &image,
+                      std::string *note)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byKey.find(request + '\n' + dataVersion);
+    if (it == byKey.end())
+    {
+        return false;
+    }
+
+    // The data has not changed, so the image counts as fresh again
+    it->second->freshUntil = std::chrono::steady_clock::now() + freshFor;
+    latest[request] = it->second;
+    const Entry &entry = touch(it->second);
+    image = entry.image;
+    if (note)
+    {
+        *note = entry.note;
+    }
+    return true;
+}
+
+void RenderCache::put(const std::string &request, const std::string &dataVersion, std::chrono::seconds freshFor, const std::string &image,
+                      const std::string &note)
+{
+    if (image.size() > budget)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string key = request + '\n' + dataVersion;
+    auto existing = byKey.find(key);
+    if (existing != byKey.end())
+    {
+        used -= existing->second->image.size();
+        entries.erase(existing->second);
+        byKey.erase(existing);
+    }
+
+    entries.push_front(Entry{key, request, image, note, std::chrono::steady_clock::now() + freshFor});
+    byKey[key] = entries.begin();
+    latest[request] = entries.begin();
+    used += image.size();
+
+    // Evict the least recently used images until the budget is met again
+    while (used > budget)
+    {
+        Entry &oldest = entries.back();
+        auto newest = latest.find(oldest.request);
+        if (newest != latest.end() && newest->second == std::prev(entries.end()))
+        {
+            latest.erase(newest);
+        }
+        used -= oldest.image.size();
+        byKey.erase(oldest.key);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,73 @@
+#include "responsecache.h"
+#include "telemetry.h"
+#include <thread>
+
+void ResponseCache::add(const std::string &command, Builder builder)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[command].builder = std::move(builder);
+}
+
+bool ResponseCache::get(const std::string &command, std::string &reply)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(command);
+        if (it == entries.end())
+        {
+            return false;
+        }
+        if (std::chrono::steady_clock::now() < it->second.expires)
+        {
+            Telemetry::instance().increment("equity_cache_requests_total", "cache=\"response\",result=\"hit\"");
+            reply = it->second.reply;
+            return true;
+        }
+    }
+    Telemetry::instance().increment("equity_cache_requests_total", "cache=\"response\",result=\"miss\"");
+
+    // Cold path: no valid reply available, build it now
+    reply = rebuild(command);
+    return true;
+}
+
+void ResponseCache::refreshExpiring()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto refreshAt = std::chrono::steady_clock::now() + RESPONSE_REFRESH_LEAD;
+    for (auto &[command, entry] : entries)
+    {
+        if (!entry.refreshing && entry.expires <= refreshAt)
+        {
+            entry.refreshing = true;
+            std::thread([this, name = command]()
+                        { rebuild(name); })
+                .detach();
+        }
+    }
+}
+
+std::string ResponseCache::rebuild(const std::string &command)
+{
+    Builder builder;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        builder = entries[command].builder;
+    }
+
+    // Fetching and formatting happens without holding the lock
+    bool marketOpen = false;
+    bool complete = true;
+    std::string reply = builder(marketOpen, complete);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry &entry = entries[command];
+    entry.refreshing = false;
+    if (reply.empty() || !complete) // Prices are missing; keep the previous reply and try again on the next refresh or request
+    {
+        return reply;
+    }
+    entry.reply = reply;
+    entry.expires = std::chrono::steady_clock::now() + (marketOpen ? RESPONSE_TTL_OPEN : RESPONSE_TTL_CLOSED);
+    return reply;
+}
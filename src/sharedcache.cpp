@@ -0,0 +1,339 @@
+#include "sharedcache.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const std::uint32_t SHARED_MAGIC = 0x45514254; // "EQBT"
+static const std::uint32_t SHARED_VERSION = 1;
+static const std::int64_t SHARED_STALE_LOCK = 5; // Seconds after which an unfinished write is considered abandoned
+
+static std::atomic<SharedCache *> attachedCache{nullptr};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Seqlocks in shared memory need lock-free atomics");
+static_assert(std::atomic<std::int64_t>::is_always_lock_free, "Seqlocks in shared memory need lock-free atomics");
+
+// Symbols are case insensitive, so keys are stored in upper case
+static std::string normalizeKey(const std::string &symbol)
+{
+    std::string key;
+    key.reserve(symbol.size());
+    for (char c : symbol)
+    {
+        if (!std::isspace(static_cast<unsigned char>(c)))
+        {
+            key += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+    }
+    return key;
+}
+
+// FNV-1a hash, used to find the home slot of a key
+static std::size_t hashKey(const std::string &key)
+{
+    std::uint64_t hash = 1469598103934665603ULL;
+    for (char c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+// Copies a string into a fixed size buffer (always null terminated)
+template <std::size_t N>
+static void copyField(char (&field)[N], const std::string &value)
+{
+    std::size_t length = std::min(value.size(), N - 1);
+    std::memcpy(field, value.data(), length);
+    field[length] = '\0';
+}
+
+// Reads a fixed size buffer into a string (does not rely on the buffer being null terminated)
+template <std::size_t N>
+static std::string readField(const char (&field)[N])
+{
+    return std::string(field, strnlen(field, N));
+}
+
+// Runs copy() between two loads of the sequence number and retries if a writer was active in the meantime
+template <typename Entry, typename Copy>
+static bool seqlockRead(const Entry &entry, Copy copy)
+{
+    for (int attempt = 0; attempt < 8; attempt++)
+    {
+        std::uint32_t before = entry.seq.load(std::memory_order_acquire);
+        if (before & 1) // Writer active
+        {
+            continue;
+        }
+        bool result = copy();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.seq.load(std::memory_order_relaxed) == before)
+        {
+            return result;
+        }
+    }
+    return false;
+}
+
+// Claims an entry for writing. Returns false if another writer is active.
+// A writer that died halfway leaves the sequence number odd; such an entry is taken over after a few seconds.
+template <typename Entry>
+static bool seqlockClaim(Entry &entry, std::uint32_t &seq)
+{
+    std::int64_t now = std::time(nullptr);
+    std::uint32_t current = entry.seq.load(std::memory_order_relaxed);
+    std::uint32_t claimed = current + 1;
+    if (current & 1)
+    {
+        if (now - entry.lockedAt.load(std::memory_order_relaxed) < SHARED_STALE_LOCK)
+        {
+            return false;
+        }
+        claimed = current + 2; // Stays odd, readers keep retrying
+    }
+    if (!entry.seq.compare_exchange_strong(current, claimed, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+        return false;
+    }
+    entry.lockedAt.store(now, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    seq = claimed;
+    return true;
+}
+
+template <typename Entry>
+static void seqlockRelease(Entry &entry, std::uint32_t seq)
+{
+    entry.seq.store(seq + 1, std::memory_order_release);
+}
+
+// Picks the entry to write a key to: the entry already holding the key, else an empty one, else the oldest one
+template <typename Entry, std::size_t N>
+static Entry &selectSlot(Entry (&entries)[N], const std::string &key)
+{
+    std::size_t home = hashKey(key);
+    Entry *oldest = &entries[home % N];
+    std::int64_t oldestTime = INT64_MAX;
+    for (std::size_t i = 0; i < SHARED_PROBE_LENGTH; i++)
+    {
+        Entry &entry = entries[(home + i) % N];
+        std::int64_t updated = 0;
+        bool sameKey = false;
+        seqlockRead(entry, [&]()
+                    {
+                        updated = entry.updated;
+                        sameKey = (readField(entry.key) == key);
+                        return true; });
+        if (sameKey || updated == 0)
+        {
+            return entry;
+        }
+        if (updated < oldestTime)
+        {
+            oldestTime = updated;
+            oldest = &entry;
+        }
+    }
+    return *oldest;
+}
+
+SharedCache::SharedCache(SharedRegion *region) : region(region) {}
+
+bool SharedCache::attach(const std::string &name)
+{
+    if (attachedCache.load() != nullptr)
+    {
+        return true;
+    }
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        std::cerr << "Could not open shared memory object " << name << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // The first process to attach sets the size (newly created memory is zero filled, which is a valid empty cache)
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size < static_cast<off_t>(sizeof(SharedRegion)))
+    {
+        if (ftruncate(fd, sizeof(SharedRegion)) != 0 && (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SharedRegion))))
+        {
+            std::cerr << "Could not resize shared memory object " << name << ": " << std::strerror(errno) << std::endl;
+            close(fd);
+            return false;
+        }
+    }
+
+    void *memory = mmap(nullptr, sizeof(SharedRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        std::cerr << "Could not map shared memory object " << name << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    SharedRegion *region = static_cast<SharedRegion *>(memory);
+    if (region->magic == 0)
+    {
+        region->version = SHARED_VERSION;
+        region->magic = SHARED_MAGIC;
+    }
+    if (region->magic != SHARED_MAGIC || region->version != SHARED_VERSION)
+    {
+        std::cerr << "Shared memory object " << name << " has an incompatible layout." << std::endl;
+        munmap(memory, sizeof(SharedRegion));
+        return false;
+    }
+
+    attachedCache.store(new SharedCache(region));
+    return true;
+}
+
+SharedCache *SharedCache::instance()
+{
+    return attachedCache.load(std::memory_order_acquire);
+}
+
+bool SharedCache::readQuote(const std::string &symbol, Metrics &metrics)
+{
+    std::string key = normalizeKey(symbol);
+    std::size_t home = hashKey(key);
+    std::time_t now = std::time(nullptr);
+
+    for (std::size_t i = 0; i < SHARED_PROBE_LENGTH; i++)
+    {
+        const SharedQuoteEntry &entry = region->quotes[(home + i) % SHARED_QUOTE_SLOTS];
+        Metrics copy;
+        std::int64_t updated = 0;
+        bool found = seqlockRead(entry, [&]()
+                                 {
+                                     if (readField(entry.key) != key)
+                                     {
+                                         return false;
+                                     }
+                                     updated = entry.updated;
+                                     copy.name = readField(entry.name);
+                                     copy.currency = readField(entry.currency);
+                                     copy.symbol = readField(entry.symbol);
+                                     copy.marketState = readField(entry.marketState);
+                                     copy.marketCap = entry.marketCap;
+                                     copy.peRatio = entry.peRatio;
+                                     copy.latestPrice = entry.latestPrice;
+                                     copy.latestChange = entry.latestChange;
+                                     copy.openPrice = entry.openPrice;
+                                     copy.dayLow = entry.dayLow;
+                                     copy.dayHigh = entry.dayHigh;
+                                     copy.prevClose = entry.prevClose;
+                                     copy.fiftyTwoWeekLow = entry.fiftyTwoWeekLow;
+                                     copy.fiftyTwoWeekHigh = entry.fiftyTwoWeekHigh;
+                                     copy.avg_50 = entry.avg_50;
+                                     copy.avg_200 = entry.avg_200;
+                                     copy.avgVol_3mo = entry.avgVol_3mo;
+                                     return true; });
+        if (found)
+        {
+            std::time_t ttl = (copy.marketState == "REGULAR") ? SHARED_QUOTE_TTL_OPEN : SHARED_QUOTE_TTL_CLOSED;
+            if (now - updated > ttl)
+            {
+                return false;
+            }
+            metrics = copy;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SharedCache::writeQuote(const std::string &symbol, const Metrics &metrics)
+{
+    std::string key = normalizeKey(symbol);
+    if (key.empty() || key.size() >= sizeof(SharedQuoteEntry::key))
+    {
+        return;
+    }
+
+    SharedQuoteEntry &entry = selectSlot(region->quotes, key);
+    std::uint32_t seq;
+    if (!seqlockClaim(entry, seq))
+    {
+        return;
+    }
+    copyField(entry.key, key);
+    copyField(entry.name, metrics.name);
+    copyField(entry.currency, metrics.currency);
+    copyField(entry.symbol, metrics.symbol);
+    copyField(entry.marketState, metrics.marketState);
+    entry.marketCap = metrics.marketCap;
+    entry.peRatio = metrics.peRatio;
+    entry.latestPrice = metrics.latestPrice;
+    entry.latestChange = metrics.latestChange;
+    entry.openPrice = metrics.openPrice;
+    entry.dayLow = metrics.dayLow;
+    entry.dayHigh = metrics.dayHigh;
+    entry.prevClose = metrics.prevClose;
+    entry.fiftyTwoWeekLow = metrics.fiftyTwoWeekLow;
+    entry.fiftyTwoWeekHigh = metrics.fiftyTwoWeekHigh;
+    entry.avg_50 = metrics.avg_50;
+    entry.avg_200 = metrics.avg_200;
+    entry.avgVol_3mo = metrics.avgVol_3mo;
+    entry.updated = std::time(nullptr);
+    seqlockRelease(entry, seq);
+}
+
+bool SharedCache::readOHLC(const std::string &symbol, std::time_t duration, std::string &csv)
+{
+    std::string key = normalizeKey(symbol) + "|" + std::to_string(duration);
+    std::size_t home = hashKey(key);
+    std::time_t now = std::time(nullptr);
+
+    for (std::size_t i = 0; i < SHARED_PROBE_LENGTH; i++)
+    {
+        const SharedOHLCEntry &entry = region->ohlc[(home + i) % SHARED_OHLC_SLOTS];
+        std::string copy;
+        std::int64_t updated = 0;
+        bool found = seqlockRead(entry, [&]()
+                                 {
+                                     if (readField(entry.key) != key)
+                                     {
+                                         return false;
+                                     }
+                                     updated = entry.updated;
+                                     copy.assign(entry.csv, std::min<std::size_t>(entry.length, SHARED_OHLC_CAPACITY));
+                                     return true; });
+        if (found)
+        {
+            if (now - updated > SHARED_OHLC_TTL)
+            {
+                return false;
+            }
+            csv = std::move(copy);
+            return true;
+        }
+    }
+    return false;
+}
+
+void SharedCache::writeOHLC(const std::string &symbol, std::time_t duration, const std::string &csv)
+{
+    std::string key = normalizeKey(symbol) + "|" + std::to_string(duration);
+    if (key.size() >= sizeof(SharedOHLCEntry::key) || csv.size() > SHARED_OHLC_CAPACITY)
+    {
+        return;
+    }
+
+    SharedOHLCEntry &entry = selectSlot(region->ohlc, key);
+    std::uint32_t seq;
+    if (!seqlockClaim(entry, seq))
+    {
+        return;
+    }
+    copyField(entry.key, key);
+    std::memcpy(entry.csv, csv.data(), csv.size());
+    entry.length = static_cast<std::uint32_t>(csv.size());
+    entry.updated = std::time(nullptr);
+    seqlockRelease(entry, seq);
+}
@@ -0,0 +1,248 @@
+#include "symbolindex.h"
+#include "catalog.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+// Returns the text in lowercase
+static std::string lowercase(std::string_view text)
+{
+    std::string result(text);
+    for (char &character : result)
+    {
+        character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+    }
+    return result;
+}
+
+// Returns the distinct trigrams of a text. Only letters and digits count (lowercase); every word is padded
+// with two spaces in front and one behind, so the start of a word weighs more and words of one or two
+// characters have trigrams too
+static std::vector<uint32_t> textTrigrams(std::string_view text)
+{
+    std::string padded = "  ";
+    for (char character : text)
+    {
+        unsigned char c = static_cast<unsigned char>(character);
+        if (std::isalnum(c))
+        {
+            padded.push_back(static_cast<char>(std::tolower(c)));
+        }
+        else if (padded.back() != ' ')
+        {
+            padded += "  ";
+        }
+    }
+    if (padded.back() != ' ')
+    {
+        padded.push_back(' ');
+    }
+
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i + 3 <= padded.size(); i++)
+    {
+        if (padded[i + 2] == ' ') // Trigrams between words carry no information
+        {
+            continue;
+        }
+        uint32_t trigram = (static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+                           (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+                           static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2]));
+        result.push_back(trigram);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+SymbolIndex &SymbolIndex::instance()
+{
+    static SymbolIndex index;
+    return index;
+}
+
+void SymbolIndex::add(const std::string &symbol, const std::string &name)
+{
+    if (symbol.empty() || symbol == "-")
+    {
+        return;
+    }
+
+    // Most calls are for known symbols (every fetched quote is added), which only need the shared lock
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = bySymbol.find(symbol);
+        if (it != bySymbol.end() && (name.empty() || !entries[it->second].name.empty()))
+        {
+            return;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = bySymbol.find(symbol);
+    if (it != bySymbol.end())
+    {
+        if (!name.empty() && entries[it->second].name.empty())
+        {
+            entries[it->second].name = name;
+            addNameKeys(name, it->second);
+        }
+        return;
+    }
+
+    uint32_t entry = static_cast<uint32_t>(entries.size());
+    entries.push_back(SymbolMatch{symbol, name});
+    trigramCounts.push_back(0);
+    bySymbol.emplace(symbol, entry);
+    byLowercaseSymbol.emplace(lowercase(symbol), entry);
+    insertKey(symbolKeys, lowercase(symbol), entry);
+    addNameKeys(name, entry);
+}
+
+void SymbolIndex::addCatalog(const Catalog &catalog)
+{
+    for (const CatalogGroup &group : catalog.groups())
+    {
+        for (size_t i = 0; i < group.symbols.size(); i++)
+        {
+            add(group.symbols[i], i < group.names.size() ? group.names[i] : "");
+        }
+    }
+}
+
+std::vector<SymbolMatch> SymbolIndex::lookup(std::string_view prefix, size_t limit) const
+{
+    std::string key = lowercase(prefix);
+    std::vector<SymbolMatch> matches;
+    std::vector<uint32_t> found;
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (const std::vector<Key> *keys : {&symbolKeys, &nameKeys})
+    {
+        auto it = std::lower_bound(keys->begin(), keys->end(), key, [](const Key &a, const std::string &b)
+                                   { return a.text < b; });
+        for (; it != keys->end() && matches.size() < limit && it->text.compare(0, key.size(), key) == 0; ++it)
+        {
+            if (std::find(found.begin(), found.end(), it->entry) == found.end())
+            {
+                found.push_back(it->entry);
+                matches.push_back(entries[it->entry]);
+            }
+        }
+    }
+    return matches;
+}
+
+std::vector<SearchResult> SymbolIndex::search(std::string_view query, size_t limit) const
+{
+    std::vector<uint32_t> queryTrigrams = textTrigrams(query);
+    std::vector<SearchResult> results;
+    if (queryTrigrams.empty())
+    {
+        return results;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    // Count the shared trigrams of every name that has at least one (the counters are reused by the thread)
+    static thread_local std::vector<uint16_t> shared;
+    static thread_local std::vector<uint32_t> touched;
+    shared.resize(std::max(shared.size(), entries.size()));
+    touched.clear();
+    for (uint32_t trigram : queryTrigrams)
+    {
+        auto it = trigrams.find(trigram);
+        if (it == trigrams.end())
+        {
+            continue;
+        }
+        for (uint32_t entry : it->second)
+        {
+            if (shared[entry]++ == 0)
+            {
+                touched.push_back(entry);
+            }
+        }
+    }
+
+    // Score the names; only the best ones are copied
+    std::vector<std::pair<double, uint32_t>> scores;
+    scores.reserve(touched.size());
+    for (uint32_t entry : touched)
+    {
+        double containment = static_cast<double>(shared[entry]) / queryTrigrams.size();
+        double precision = static_cast<double>(shared[entry]) / std::max<uint16_t>(trigramCounts[entry], 1);
+        scores.emplace_back(0.8 * containment + 0.2 * precision, entry);
+        shared[entry] = 0;
+    }
+
+    size_t count = std::min(limit, scores.size());
+    std::partial_sort(scores.begin(), scores.begin() + count, scores.end(), [this](const auto &a, const auto &b)
+                      { return a.first != b.first ? a.first > b.first : entries[a.second].symbol < entries[b.second].symbol; });
+    for (size_t i = 0; i < count; i++)
+    {
+        results.push_back(SearchResult{entries[scores[i].second], scores[i].first});
+    }
+    return results;
+}
+
+std::string SymbolIndex::resolve(const std::string &text) const
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = byLowercaseSymbol.find(lowercase(text));
+        if (it != byLowercaseSymbol.end())
+        {
+            return entries[it->second].symbol;
+        }
+    }
+
+    // Tickers are short and typed in capitals ("T", "BA", "GOLD"), and an unknown ticker must reach Yahoo Finance as typed,
+    // so only text that cannot be a ticker is looked up by name
+    bool nameLike = text.size() >= RESOLVE_MIN_LENGTH && std::any_of(text.begin(), text.end(), [](char character)
+                                                                      { return std::islower(static_cast<unsigned char>(character)) || character == ' '; });
+    if (!nameLike)
+    {
+        return text;
+    }
+
+    std::vector<SearchResult> best = search(text, 1);
+    if (!best.empty() && best[0].score >= RESOLVE_MIN_SCORE)
+    {
+        return best[0].match.symbol;
+    }
+    return text;
+}
+
+size_t SymbolIndex::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries.size();
+}
+
+void SymbolIndex::insertKey(std::vector<Key> &keys, std::string text, uint32_t entry)
+{
+    auto it = std::lower_bound(keys.begin(), keys.end(), text, [](const Key &a, const std::string &b)
+                               { return a.text < b; });
+    keys.insert(it, Key{std::move(text), entry});
+}
+
+void SymbolIndex::addNameKeys(const std::string &name, uint32_t entry)
+{
+    // Every word of the name starts a key, so "oil" finds "Crude Oil"
+    std::string text = lowercase(name);
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (!std::isspace(static_cast<unsigned char>(text[i])) && (i == 0 || std::isspace(static_cast<unsigned char>(text[i - 1]))))
+        {
+            insertKey(nameKeys, text.substr(i), entry);
+        }
+    }
+
+    std::vector<uint32_t> nameTrigrams = textTrigrams(name);
+    for (uint32_t trigram : nameTrigrams)
+    {
+        trigrams[trigram].push_back(entry);
+    }
+    trigramCounts[entry] = static_cast<uint16_t>(std::min<size_t>(nameTrigrams.size(), UINT16_MAX));
+}
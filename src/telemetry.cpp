@@ -0,0 +1,366 @@
+#include "telemetry.h"
+#include "format.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: SO_NOSIGPIPE is set on the socket instead
+#endif
+
+// Bucket boundaries (in seconds) of the exported histograms
+static constexpr double EXPORT_BOUNDARIES[] = {0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30};
+
+// Quantiles that are exported as gauges, so alerts do not need histogram_quantile
+static constexpr double EXPORT_QUANTILES[] = {0.5, 0.9, 0.99};
+
+// Command of the current thread (see CommandScope)
+static thread_local std::string currentCommand = BACKGROUND_COMMAND;
+
+size_t LatencyHistogram::bucketOf(uint64_t microseconds)
+{
+    if (microseconds < LINEAR_BUCKETS)
+    {
+        return microseconds;
+    }
+    int exponent = 63 - __builtin_clzll(microseconds); // At least 4
+    size_t sub = (microseconds >> (exponent - 3)) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (exponent - 4) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket)
+{
+    if (bucket < LINEAR_BUCKETS)
+    {
+        return bucket;
+    }
+    int exponent = static_cast<int>((bucket - LINEAR_BUCKETS) / SUB_BUCKETS) + 4;
+    uint64_t sub = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+    uint64_t lower = (SUB_BUCKETS + sub) << (exponent - 3);
+    return lower + ((uint64_t(1) << (exponent - 3)) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration duration)
+{
+    int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    uint64_t value = microseconds > 0 ? static_cast<uint64_t>(microseconds) : 0;
+    buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::sumMicroseconds() const
+{
+    return sum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::countAtMost(uint64_t microseconds) const
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < BUCKETS && bucketUpperBound(i) <= microseconds; i++)
+    {
+        result += buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+uint64_t LatencyHistogram::quantile(double q) const
+{
+    uint64_t recorded = count();
+    if (recorded == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * recorded)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKETS - 1);
+}
+
+Telemetry &Telemetry::instance()
+{
+    static Telemetry telemetry;
+    return telemetry;
+}
+
+void Telemetry::record(const std::string &command, const std::string &stage, std::chrono::steady_clock::duration duration)
+{
+    observe("equity_stage_duration_seconds", "command=\"" + command + "\",stage=\"" + stage + "\"", duration);
+}
+
+void Telemetry::observe(const std::string &family, const std::string &labels, std::chrono::steady_clock::duration duration)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto histogramFamily = histograms.find(family);
+        if (histogramFamily != histograms.end())
+        {
+            auto it = histogramFamily->second.find(labels);
+            if (it != histogramFamily->second.end())
+            {
+                it->second->record(duration);
+                return;
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unique_ptr<LatencyHistogram> &histogram = histograms[family][labels];
+    if (!histogram)
+    {
+        histogram = std::make_unique<LatencyHistogram>();
+    }
+    histogram->record(duration);
+}
+
+void Telemetry::recordTransfer(const TransferTiming &timing)
+{
+    std::string labels = "host=\"" + timing.host + "\",endpoint=\"" + timing.endpoint + "\"";
+    const std::string family = "equity_upstream_duration_seconds";
+
+    // A reused connection skips the DNS lookup, connect and handshake; recording zeros would hide their real cost
+    if (!timing.reusedConnection)
+    {
+        observe(family, labels + ",phase=\"dns\"", timing.nameLookup);
+        observe(family, labels + ",phase=\"connect\"", timing.connect - timing.nameLookup);
+        if (timing.tlsHandshake.count() > 0)
+        {
+            observe(family, labels + ",phase=\"tls\"", timing.tlsHandshake - timing.connect);
+        }
+    }
+    observe(family, labels + ",phase=\"first_byte\"", timing.firstByte);
+    observe(family, labels + ",phase=\"total\"", timing.total);
+
+    increment("equity_upstream_requests_total", labels + ",connection=\"" + (timing.reusedConnection ? "reused" : "new") + "\"");
+    increment("equity_upstream_bytes_total", labels, timing.bytes);
+}
+
+void Telemetry::increment(const std::string &name, const std::string &labels, uint64_t amount)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto family = counters.find(name);
+        if (family != counters.end())
+        {
+            auto it = family->second.find(labels);
+            if (it != family->second.end())
+            {
+                it->second->fetch_add(amount, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unique_ptr<std::atomic<uint64_t>> &counter = counters[name][labels];
+    if (!counter)
+    {
+        counter = std::make_unique<std::atomic<uint64_t>>(0);
+    }
+    counter->fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Telemetry::addCollector(Collector collector)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    collectors.push_back(std::move(collector));
+}
+
+std::string Telemetry::exportPrometheus() const
+{
+    TextBuffer out;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    for (const auto &[name, family] : histograms)
+    {
+        out.append("# TYPE ").append(name).append(" histogram\n");
+        for (const auto &[labels, histogram] : family)
+        {
+            for (double boundary : EXPORT_BOUNDARIES)
+            {
+                out.append(name).append("_bucket{").append(labels).append(",le=\"").appendFixed(boundary, 4).append("\"} ")
+                   .appendInteger(histogram->countAtMost(static_cast<uint64_t>(boundary * 1e6))).append('\n');
+            }
+            out.append(name).append("_bucket{").append(labels).append(",le=\"+Inf\"} ").appendInteger(histogram->count()).append('\n');
+            out.append(name).append("_sum{").append(labels).append("} ").appendFixed(histogram->sumMicroseconds() / 1e6, 6).append('\n');
+            out.append(name).append("_count{").append(labels).append("} ").appendInteger(histogram->count()).append('\n');
+        }
+
+        // e.g. equity_stage_duration_seconds -> equity_stage_duration_quantile_seconds
+        std::string quantileName = name.substr(0, name.size() - std::string("_seconds").size()) + "_quantile_seconds";
+        out.append("# TYPE ").append(quantileName).append(" gauge\n");
+        for (const auto &[labels, histogram] : family)
+        {
+            for (double q : EXPORT_QUANTILES)
+            {
+                out.append(quantileName).append('{').append(labels).append(",quantile=\"").appendFixed(q, 2).append("\"} ")
+                   .appendFixed(histogram->quantile(q) / 1e6, 6).append('\n');
+            }
+        }
+    }
+
+    for (const auto &[name, family] : counters)
+    {
+        out.append("# TYPE ").append(name).append(" counter\n");
+        for (const auto &[labels, counter] : family)
+        {
+            out.append(name);
+            if (!labels.empty())
+            {
+                out.append('{').append(labels).append('}');
+            }
+            out.append(' ').appendInteger(counter->load(std::memory_order_relaxed)).append('\n');
+        }
+    }
+
+    std::string result = out.str();
+    for (const Collector &collector : collectors)
+    {
+        collector(result);
+    }
+    return result;
+}
+
+CommandScope::CommandScope(const std::string &command) : previous(currentCommand), start(std::chrono::steady_clock::now())
+{
+    currentCommand = command;
+}
+
+CommandScope::~CommandScope()
+{
+    Telemetry::instance().record(currentCommand, "total", std::chrono::steady_clock::now() - start);
+    currentCommand = previous;
+}
+
+const std::string &CommandScope::current()
+{
+    return currentCommand;
+}
+
+StageTimer::StageTimer(const char *stage) : stage(stage), start(std::chrono::steady_clock::now())
+{
+}
+
+StageTimer::~StageTimer()
+{
+    Telemetry::instance().record(currentCommand, stage, std::chrono::steady_clock::now() - start);
+}
+
+MetricsServer::MetricsServer(uint16_t port) : port(port)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    stopping = true;
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+    if (socket >= 0)
+    {
+        close(socket);
+    }
+}
+
+bool MetricsServer::start()
+{
+    socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socket < 0)
+    {
+        std::cerr << "Could not create the metrics socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(socket, 16) < 0)
+    {
+        std::cerr << "Could not listen for metrics on port " << port << ": " << std::strerror(errno) << std::endl;
+        close(socket);
+        socket = -1;
+        return false;
+    }
+
+    thread = std::thread(&MetricsServer::serve, this);
+    std::cout << "Serving metrics at http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::serve()
+{
+    while (!stopping)
+    {
+        pollfd request{socket, POLLIN, 0};
+        if (poll(&request, 1, 1000) <= 0)
+        {
+            continue;
+        }
+        int client = accept(socket, nullptr, nullptr);
+        if (client < 0)
+        {
+            continue;
+        }
+
+#ifdef SO_NOSIGPIPE
+        int noSignal = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+
+        // Only the request line matters; wait at most a second for it
+        timeval timeout{1, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        char buffer[1024];
+        ssize_t length = recv(client, buffer, sizeof(buffer) - 1, 0);
+        std::string requestLine = (length > 0) ? std::string(buffer, length) : "";
+
+        std::string status = "200 OK";
+        std::string body;
+        if (requestLine.rfind("GET /metrics", 0) == 0)
+        {
+            body = Telemetry::instance().exportPrometheus();
+        }
+        else
+        {
+            status = "404 Not Found";
+            body = "Not found\n";
+        }
+
+        std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                               std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+        for (size_t sent = 0; sent < response.size();)
+        {
+            ssize_t written = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0)
+            {
+                break;
+            }
+            sent += written;
+        }
+        close(client);
+    }
+}
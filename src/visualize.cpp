@@ -1,168 +1,207 @@
 #include "visualize.h"
+#include "nativechart.h"
+#include "downsample.h"
+#include "rendercache.h"
+#include "telemetry.h"
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <mutex>
 
-void priceGraph(std::string symbol, std::string duration, int mode)
+// Width of the axes of a 900 pixel wide figure (Matplot++ places the axes at 13% to 90.5% of the figure width)
+static const double PLOT_AREA_WIDTH = 900 * 0.775;
+
+// Maximum time to wait for gnuplot to deliver an image
+static const std::chrono::seconds RENDER_TIMEOUT{15};
+
+// Number of gnuplot processes kept for Matplot++ renders, and the number of renders after which a process is replaced
+static const size_t GNUPLOT_POOL_SIZE = 4;
+static const size_t GNUPLOT_MAX_RENDERS = 200;
+
+// Long-lived figures (each with its own gnuplot process) that Matplot++ renders lease.
+// A leased figure belongs to one render only, so renders running at the same time never draw into each other's plot.
+static GnuplotPool &gnuplotPool()
 {
-    // Fetch data
-    Metrics data = fetchMetrics(symbol);
-    std::vector<std::vector<std::string>> ohlcData = fetchOHLCData(symbol, duration);
-    if (ohlcData.empty())
-    {
-        std::cerr << "No price data available." << std::endl;
-        return;
-    }
+    static GnuplotPool pool(GNUPLOT_POOL_SIZE, GNUPLOT_MAX_RENDERS);
+    return pool;
+}
 
-    if (mode != 1 && mode != 2 && mode != 3)
-    {
-        std::cerr << "Invalid mode. Please use 1, 2, or 3." << std::endl;
-        return;
-    }
+// Saves a figure and returns the encoded image.
+// Instead of a regular file, the figure is saved to a named pipe. gnuplot writes the image into the pipe
+// and closes it once the image is complete, so reading until end-of-file returns exactly the finished
+// image, without disk round-trips and without guessing how long gnuplot needs.
+// A gnuplot process that hangs costs at most RENDER_TIMEOUT; the image is then empty and the caller fails the lease,
+// which replaces the process.
+static std::string saveToMemory(const matplot::figure_handle &fig, const std::string &extension)
+{
+    // Render the figure and make gnuplot close the output, which ends the image
+    return readFromGnuplot(fig, extension, [&fig](const std::string &pipePath)
+                           {
+                               fig->save(pipePath);
+                               fig->backend()->run_command("unset output"); },
+                           RENDER_TIMEOUT);
+}
 
-    std::vector<double> openingPrices, closingPrices;
-    std::vector<std::string> dates;
-    std::vector<double> xAxis; // Needed for data plotting
+GnuplotPoolStats getGnuplotPoolStats()
+{
+    return gnuplotPool().stats();
+}
 
-    // Extract opening and closing prices and fill xAxis vector (prices will be plotted against these points)
-    double i = 0;
-    for (const auto &row : ohlcData)
-    {
-        xAxis.push_back(i);
-        if (row.size() >= 5)
-        {
-            try
-            {
-                openingPrices.push_back(std::stod(row[1])); // Opening price (column 1 in OHLC data)
-                closingPrices.push_back(std::stod(row[4])); // Closing price (column 4 in OHLC data)
-                dates.push_back(row[0]);                    // Date in format y/m/d (column 0 in OHLC data)
-            }
-            catch(const std::exception& e)
-            {
-                std::cerr << e.what() << '\n';
-                return;
-            }    
-        }
-        i++;
-    }
+// Version of the chart layout; increase it when the look of the charts changes, so older cached images are not served
+static const int CHART_VERSION = 1;
 
-    // Generate evenly spaced x values
-    std::vector<double> xTicks;
-    std::vector<std::string> xtickLabels; // New vector for x-tick labels
+// Encoded charts of recent requests
+static RenderCache &renderCache()
+{
+    static RenderCache cache(RENDER_CACHE_BUDGET);
+    return cache;
+}
 
-    if (dates.size() <= 20)
+// Returns the chart of a request from the render cache, or fetches the data, draws the chart and caches it.
+// A fresh chart is returned without fetching (unless refresh is set); otherwise the chart is only drawn again
+// if the last bar changed. The stored chart stays fresh for freshFor. The note that draw gives the chart is
+// kept with it and written to note (if not nullptr).
+static std::string cachedChart(const std::string &request, const std::string &symbol, const std::string &duration,
+                               const std::function<std::string(const ChartData &, std::string &)> &draw, std::chrono::seconds freshFor,
+                               bool refresh, std::string *note = nullptr)
+{
+    std::string image;
+    if (!refresh && renderCache().getFresh(request, image, note))
     {
-        // Show all dates if the duration is less than or equal to 20 days
-        xTicks = matplot::linspace(0, openingPrices.size() - 1, dates.size());
-        xtickLabels = dates; // Use all dates as x-tick labels
+        Telemetry::instance().increment("equity_cache_requests_total", "cache=\"render\",result=\"hit\"");
+        return image;
     }
-    else
+
+    ChartData data;
+    if (!loadChartData(symbol, duration, data))
     {
-        // Show fewer ticks for longer durations
-        int desiredTicks = 10; // You can adjust this value as needed
-        int step = static_cast<int>(std::ceil(static_cast<double>(dates.size()) / desiredTicks));
-        for (int i = 0; i < dates.size(); i += step)
-        {
-            xTicks.push_back(static_cast<double>(i));
-            xtickLabels.push_back(dates[i]); // Use selected dates as x-tick labels
-        }
+        return "";
     }
-    
-    // Create the price graph
-    auto fig = matplot::figure(true);
-    fig->quiet_mode(true);
-    fig->size(900, 600); 
-    matplot::hold(matplot::on);
-    matplot::xlim({-1, xAxis[xAxis.size()-1]+1}); // Small offset from edges of figure, to make sure the line(s) does not cross the axis
 
-    if (mode == 1 || mode == 3)
+    char lastBar[96];
+    std::snprintf(lastBar, sizeof(lastBar), "%s %.17g", data.dates.back().c_str(), data.close.back());
+    if (renderCache().get(request, lastBar, freshFor, image, note))
     {
-        matplot::plot(xAxis, openingPrices)->color("blue").line_width(2).display_name("Open");
+        Telemetry::instance().increment("equity_cache_requests_total", "cache=\"render\",result=\"hit\"");
+        return image;
     }
+    Telemetry::instance().increment("equity_cache_requests_total", "cache=\"render\",result=\"miss\"");
 
-    if (mode == 2 || mode == 3)
+    std::string chartNote;
+    image = draw(data, chartNote);
+    if (!image.empty())
     {
-        matplot::plot(xAxis, closingPrices)->color("black").line_width(2).display_name("Close");
+        renderCache().put(request, lastBar, freshFor, image, chartNote);
     }
+    if (note)
+    {
+        *note = chartNote;
+    }
+    return image;
+}
 
-    ::matplot::legend({});
-    matplot::ylabel("Price in " + data.currency);
-    matplot::xticks(xTicks);
-    matplot::xticklabels(xtickLabels);
-    matplot::xtickangle(35);
+// Renderer used by priceGraph and createCandleChart
+static std::atomic<ChartRenderer> currentRenderer{ChartRenderer::Native};
 
-    // Get the path to the "images" folder (assuming one level up from the executable)
-    std::string exePath = std::filesystem::current_path().string();
-    std::string imagePath = exePath + "/../images/";
+void setChartRenderer(ChartRenderer renderer)
+{
+    currentRenderer = renderer;
+}
+
+ChartRenderer getChartRenderer()
+{
+    return currentRenderer;
+}
 
-    // Create the "images" folder if it doesn't exist
-    std::filesystem::create_directory(imagePath);
+// Image format used by priceGraph and createCandleChart
+static std::atomic<ImageOptions> currentImageOptions{ImageOptions()};
 
-    // Save the plot in the "images" folder
-    std::string filename = imagePath + "price_graph.png";
-    matplot::save(filename);
-    // matplot::show();
+void setImageOptions(ImageOptions options)
+{
+    currentImageOptions = options;
 }
 
-void createCandleChart(std::string symbol, std::string duration, bool withVolume)
+ImageOptions getImageOptions()
+{
+    return currentImageOptions;
+}
+
+std::string imageFileExtension(ImageFormat format)
+{
+    return (format == ImageFormat::SVG) ? "svg" : "png";
+}
+
+std::string imageMimeType(ImageFormat format)
+{
+    return (format == ImageFormat::SVG) ? "image/svg+xml" : "image/png";
+}
+
+bool loadChartData(const std::string &symbol, const std::string &duration, ChartData &chartData)
 {
     // Fetch data
     Metrics data = fetchMetrics(symbol);
     std::vector<std::vector<std::string>> ohlcData = fetchOHLCData(symbol, duration);
     if (ohlcData.empty())
     {
-        std::cout << "No OHLC data available." << std::endl;
-        return;
+        std::cerr << "No price data available." << std::endl;
+        return false;
     }
 
-    std::vector<std::string> dates, candleColor;
-    std::vector<double> openingPrices, closingPrices, highPrices, lowPrices, volumes;
-    std::vector<double> xAxis; // Needed for data plotting
+    chartData = ChartData();
+    chartData.currency = data.currency;
 
-    // Extract OHLC data and fill xAxis vector (prices and volumes will be plotted against these points)
-    double i = 0;
+    // Extract OHLC data (volumes are optional, missing volumes are set to 0)
     for (const auto &row : ohlcData)
     {
-        xAxis.push_back(i);
         if (row.size() >= 5)
         {
             try
             {
-                dates.push_back(row[0]);                    // Date in format y/m/d (column 0 in OHLC data)
-                openingPrices.push_back(std::stod(row[1])); // Opening price (column 1 in OHLC data)
-                highPrices.push_back(std::stod(row[2]));    // High price (column 2 in OHLC data)
-                lowPrices.push_back(std::stod(row[3]));     // Low price (column 3 in OHLC data)
-                closingPrices.push_back(std::stod(row[4])); // Closing price (column 4 in OHLC data)
-                if (withVolume && row.size() >= 6)
-                {
-                    volumes.push_back(std::stod(row[5])); // Volumes (column 5 in OHLC data)
-                }
-                if (std::stod(row[4]) >= std::stod(row[1]))
-                {
-                    candleColor.push_back("green");
-                }
-                else
-                {
-                    candleColor.push_back("red");
-                }
+                double open = std::stod(row[1]);  // Opening price (column 1 in OHLC data)
+                double high = std::stod(row[2]);  // High price (column 2 in OHLC data)
+                double low = std::stod(row[3]);   // Low price (column 3 in OHLC data)
+                double close = std::stod(row[4]); // Closing price (column 4 in OHLC data)
+                chartData.dates.push_back(row[0]); // Date in format y/m/d (column 0 in OHLC data)
+                chartData.open.push_back(open);
+                chartData.high.push_back(high);
+                chartData.low.push_back(low);
+                chartData.close.push_back(close);
             }
             catch (const std::exception &e)
             {
                 std::cerr << e.what() << '\n';
-                return;
+                return false;
+            }
+            double volume = 0;
+            if (row.size() >= 6) // Volumes (column 5 in OHLC data)
+            {
+                try
+                {
+                    volume = std::stod(row[5]);
+                }
+                catch (const std::exception &)
+                {
+                }
             }
+            chartData.volume.push_back(volume);
         }
-        i++;
     }
 
-    // Calculate lowest and highest prices (used for y-axis range)
-    double lowestPrice = *std::min_element(lowPrices.begin(), lowPrices.end());
-    double highestPrice = *std::max_element(highPrices.begin(), highPrices.end());
+    return !chartData.dates.empty();
+}
 
-    std::vector<double> xTicks;
-    std::vector<std::string> xtickLabels; // New vector for x-tick labels
+void getDateTicks(const std::vector<std::string> &dates, std::vector<double> &xTicks, std::vector<std::string> &xtickLabels)
+{
+    xTicks.clear();
+    xtickLabels.clear();
 
     if (dates.size() <= 20)
     {
         // Show all dates if the duration is less than or equal to 20 days
-        xTicks = matplot::linspace(0, openingPrices.size() - 1, dates.size());
+        for (size_t i = 0; i < dates.size(); i++)
+        {
+            xTicks.push_back(static_cast<double>(i));
+        }
         xtickLabels = dates; // Use all dates as x-tick labels
     }
     else
@@ -176,34 +215,128 @@ void createCandleChart(std::string symbol, std::string duration, bool withVolume
             xtickLabels.push_back(dates[i]); // Use selected dates as x-tick labels
         }
     }
+}
 
-    // Create the candlestick chart
-    auto fig = matplot::figure(true);
-    fig->quiet_mode(true);
-    fig->size(900, 600);
-    matplot::hold(matplot::on);
-    matplot::ylim({+lowestPrice * 0.99, +highestPrice * 1.01});
-    matplot::ylabel("Price in " + data.currency);
-    matplot::xlim({-1, xAxis[xAxis.size() - 1] + 1}); // Small offset to make sure the first and last candles are not in the axis
-    matplot::xticks(xTicks);
-    matplot::xticklabels(xtickLabels);
-    matplot::xtickangle(35);
-
-    // Draw candlesticks
-    for (int i = 0; i < xAxis.size(); i++)
+// Draws the price graph with Matplot++ (gnuplot)
+static std::string matplotPriceGraph(const ChartData &data, int mode, const std::string &extension)
+{
+    std::vector<double> xTicks;
+    std::vector<std::string> xtickLabels;
+    getDateTicks(data.dates, xTicks, xtickLabels);
+
+    // Create the price graph (in a pooled figure that belongs to this render only)
+    GnuplotPool::Lease lease = gnuplotPool().lease(900, 600);
+    matplot::axes_handle ax = lease.axes();
+    matplot::hold(ax, matplot::on);
+    matplot::xlim(ax, {-1, static_cast<double>(data.dates.size())}); // Small offset from edges of figure, to make sure the line(s) does not cross the axis
+
+    // Long periods have more points than the plot has pixel columns, so every line is reduced to one point per pixel
+    std::vector<double> xs, ys;
+    size_t maxPoints = static_cast<size_t>(PLOT_AREA_WIDTH);
+    if (mode == 1 || mode == 3)
+    {
+        downsampleLTTB(data.open, maxPoints, xs, ys);
+        matplot::plot(ax, xs, ys)->color("blue").line_width(2).display_name("Open");
+    }
+
+    if (mode == 2 || mode == 3)
+    {
+        downsampleLTTB(data.close, maxPoints, xs, ys);
+        matplot::plot(ax, xs, ys)->color("black").line_width(2).display_name("Close");
+    }
+
+    matplot::legend(ax, std::vector<std::string>{});
+    matplot::ylabel(ax, "Price in " + data.currency);
+    matplot::xticks(ax, xTicks);
+    matplot::xticklabels(ax, xtickLabels);
+    matplot::xtickangle(ax, 35);
+
+    // Render the plot and return the image
+    std::string image = saveToMemory(lease.figure(), extension);
+    if (image.empty())
     {
-        // Draw the vertical line (wick) of the candlestick
-        matplot::plot({xAxis[i], xAxis[i]}, {highPrices[i], lowPrices[i]})->line_width(1.2).color("black").marker(matplot::line_spec::marker_style::custom);
+        lease.fail();
+    }
+    return image;
+}
+
+// Draws the candlestick chart with Matplot++ (gnuplot)
+static std::string matplotCandleChart(const ChartData &fullData, bool withVolume, const std::string &extension, bool *merged)
+{
+    // Merge days into longer candles if the plot is too narrow to show every day
+    ChartData data = downsampleCandles(fullData, static_cast<size_t>(PLOT_AREA_WIDTH / MIN_CANDLE_PITCH));
+    if (merged)
+    {
+        *merged = (data.dates.size() < fullData.dates.size());
+    }
+    const std::vector<double> &openingPrices = data.open;
+    const std::vector<double> &closingPrices = data.close;
+    const std::vector<double> &highPrices = data.high;
+    const std::vector<double> &lowPrices = data.low;
+    std::vector<double> volumes = data.volume;
+
+    // Prices and volumes are plotted against these points
+    std::vector<double> xAxis;
+    std::vector<std::string> candleColor;
+    for (size_t i = 0; i < data.dates.size(); i++)
+    {
+        xAxis.push_back(static_cast<double>(i));
+        candleColor.push_back(closingPrices[i] >= openingPrices[i] ? "green" : "red");
+    }
+
+    // Calculate lowest and highest prices (used for y-axis range)
+    double lowestPrice = *std::min_element(lowPrices.begin(), lowPrices.end());
+    double highestPrice = *std::max_element(highPrices.begin(), highPrices.end());
+
+    std::vector<double> xTicks;
+    std::vector<std::string> xtickLabels;
+    getDateTicks(data.dates, xTicks, xtickLabels);
+
+    // Create the candlestick chart (in a pooled figure that belongs to this render only)
+    GnuplotPool::Lease lease = gnuplotPool().lease(900, 600);
+    matplot::axes_handle ax = lease.axes();
+    matplot::hold(ax, matplot::on);
+    matplot::ylim(ax, {+lowestPrice * 0.99, +highestPrice * 1.01});
+    matplot::ylabel(ax, "Price in " + data.currency);
+    matplot::xlim(ax, {-1, xAxis[xAxis.size() - 1] + 1}); // Small offset to make sure the first and last candles are not in the axis
+    matplot::xticks(ax, xTicks);
+    matplot::xticklabels(ax, xtickLabels);
+    matplot::xtickangle(ax, 35);
 
+    // All candles are drawn with a handful of plot objects instead of a few objects per candle:
+    // one line series for the wicks and one per body color. Segments inside a series are separated by NaN,
+    // which gnuplot treats as a gap. Bodies (and volume bars) are vertical segments with a line width
+    // equal to 0.4 x-units converted to pixels.
+    const double gap = std::numeric_limits<double>::quiet_NaN();
+    double barWidth = 0.4 * PLOT_AREA_WIDTH / (xAxis.size() + 1);
+    double minBodyHeight = (highestPrice - lowestPrice) * 0.002; // Keeps bodies with open == close visible
+    std::vector<double> wickX, wickY, greenX, greenY, redX, redY;
+    for (size_t i = 0; i < xAxis.size(); i++)
+    {
         // Calculate the top and bottom of the candlestick body
         double top = std::max(openingPrices[i], closingPrices[i]);
         double bottom = std::min(openingPrices[i], closingPrices[i]);
+        if (top - bottom < minBodyHeight)
+        {
+            top += minBodyHeight / 2;
+            bottom -= minBodyHeight / 2;
+        }
 
-        // Draw the filled rectangle (candlestick body)
-        float offsetX = 0.2;
-        auto r = matplot::rectangle(xAxis[i] - offsetX, bottom, offsetX * 2, (top - bottom));
-        r->fill(true);
-        r->color(candleColor[i]);
+        wickX.insert(wickX.end(), {xAxis[i], xAxis[i], gap});
+        wickY.insert(wickY.end(), {highPrices[i], lowPrices[i], gap});
+        std::vector<double> &bodyX = (candleColor[i] == "green") ? greenX : redX;
+        std::vector<double> &bodyY = (candleColor[i] == "green") ? greenY : redY;
+        bodyX.insert(bodyX.end(), {xAxis[i], xAxis[i], gap});
+        bodyY.insert(bodyY.end(), {bottom, top, gap});
+    }
+    matplot::plot(ax, wickX, wickY)->line_width(1.2).color("black");
+    if (!greenX.empty())
+    {
+        matplot::plot(ax, greenX, greenY)->line_width(barWidth).color("green");
+    }
+    if (!redX.empty())
+    {
+        matplot::plot(ax, redX, redY)->line_width(barWidth).color("red");
     }
 
     if (withVolume)
@@ -214,46 +347,142 @@ void createCandleChart(std::string symbol, std::string duration, bool withVolume
             volume /= 10000000;
         }
 
-        // Calculate lowest and highest volumes (used for y-axis range)
-        double lowestVolume = *std::min_element(volumes.begin(), volumes.end());
+        // Calculate highest volume (used for y-axis range)
         double highestVolume = *std::max_element(volumes.begin(), volumes.end());
 
-        // Draw volume bars using matplot::rectangle
-        for (int i = 0; i < xAxis.size(); i++)
+        // Draw volume bars, one series per color
+        std::vector<double> greenVolumeX, greenVolumeY, redVolumeX, redVolumeY;
+        for (size_t i = 0; i < xAxis.size(); i++)
         {
-            float width = 0.2;
-            double volumeHeight = volumes[i];
-            if (candleColor[i] == "red")
-            {
-                auto r = matplot::rectangle(xAxis[i] - width, 0, 2 * width, volumeHeight)->use_y2(true).
-                    fill(true).
-                    color({0.7f, 1.f, 0.f, 0.f}); // Red with 70% opacity
-            }
-            else
-            {
-                auto r = matplot::rectangle(xAxis[i] - width, 0, 2 * width, volumeHeight)->use_y2(true).
-                    fill(true).
-                    color({0.7f, 0.f, 1.f, 0.f}); // Green with 70% opacity
-            }
+            std::vector<double> &barX = (candleColor[i] == "red") ? redVolumeX : greenVolumeX;
+            std::vector<double> &barY = (candleColor[i] == "red") ? redVolumeY : greenVolumeY;
+            barX.insert(barX.end(), {xAxis[i], xAxis[i], gap});
+            barY.insert(barY.end(), {0, volumes[i], gap});
+        }
+        if (!redVolumeX.empty())
+        {
+            matplot::plot(ax, redVolumeX, redVolumeY)->use_y2(true).line_width(barWidth).color({0.7f, 1.f, 0.f, 0.f}); // Red with 70% opacity
+        }
+        if (!greenVolumeX.empty())
+        {
+            matplot::plot(ax, greenVolumeX, greenVolumeY)->use_y2(true).line_width(barWidth).color({0.7f, 0.f, 1.f, 0.f}); // Green with 70% opacity
         }
 
         // y2 setup
         // Note that the upper y2 limit is set to 4 times the highest volume
         // This is done to make sure that the volume bars are displayed at the bottom of the graph
         // and do not overlay the candlesticks too much
-        matplot::y2lim({0, highestVolume * 4});
-        matplot::y2label("Volume (in 10^7)");
+        matplot::y2lim(ax, {0, highestVolume * 4});
+        matplot::y2label(ax, "Volume (in 10^7)");
     }
 
-    // Get the path to the "images" folder (assuming one level up from the executable)
-    std::string exePath = std::filesystem::current_path().string();
-    std::string imagePath = exePath + "/../images/";
+    // Render the chart and return the image
+    std::string image = saveToMemory(lease.figure(), extension);
+    if (image.empty())
+    {
+        lease.fail();
+    }
+    return image;
+}
 
-    // Create the "images" folder if it doesn't exist
-    std::filesystem::create_directory(imagePath);
+std::string renderPriceGraph(const ChartData &data, int mode, ChartRenderer renderer, ImageOptions options)
+{
+    StageTimer timer("render");
+    if (data.dates.empty())
+    {
+        std::cerr << "No price data available." << std::endl;
+        return "";
+    }
+
+    if (mode != 1 && mode != 2 && mode != 3)
+    {
+        std::cerr << "Invalid mode. Please use 1, 2, or 3." << std::endl;
+        return "";
+    }
 
-    // Save the plot in the "images" folder
-    std::string filename = imagePath + "candle_chart.png";
-    matplot::save(filename);
-    // matplot::show();
+    if (renderer == ChartRenderer::Native)
+    {
+        return nativePriceGraph(data, mode, options);
+    }
+    return matplotPriceGraph(data, mode, (options.format == ImageFormat::SVG) ? "svg" : "png");
+}
+
+std::string renderCandleChart(const ChartData &data, bool withVolume, ChartRenderer renderer, ImageOptions options, bool *merged)
+{
+    StageTimer timer("render");
+    if (data.dates.empty())
+    {
+        std::cout << "No OHLC data available." << std::endl;
+        return "";
+    }
+
+    if (renderer == ChartRenderer::Native)
+    {
+        return nativeCandleChart(data, withVolume, options, merged);
+    }
+    return matplotCandleChart(data, withVolume, (options.format == ImageFormat::SVG) ? "svg" : "png", merged);
+}
+
+// Returns the part of a render cache key that identifies the renderer, image format and chart layout
+static std::string renderVersion(ChartRenderer renderer, const ImageOptions &options)
+{
+    return std::to_string(static_cast<int>(renderer)) + "." + std::to_string(static_cast<int>(options.format)) + "." +
+           std::to_string(options.compressionLevel) + "." + std::to_string(CHART_VERSION);
+}
+
+// Returns the part of a render cache key that identifies the period: its length in seconds,
+// so "1y", "1 year" and "1Y" share one cached chart
+static std::string periodKey(const std::string &duration)
+{
+    return std::to_string(getDurationInSeconds(duration)) + "s";
+}
+
+// Creates the price graph of a request through the render cache
+static std::string cachedPriceGraph(const std::string &symbol, const std::string &duration, int mode, std::chrono::seconds freshFor, bool refresh)
+{
+    ChartRenderer renderer = getChartRenderer();
+    ImageOptions options = getImageOptions();
+    std::string request = "pricegraph " + symbol + " " + periodKey(duration) + " " + std::to_string(mode) + " " + renderVersion(renderer, options);
+    return cachedChart(
+        request, symbol, duration, [mode, renderer, options](const ChartData &data, std::string &)
+        { return renderPriceGraph(data, mode, renderer, options); },
+        freshFor, refresh);
+}
+
+// Creates the candlestick chart of a request through the render cache
+static std::string cachedCandleChart(const std::string &symbol, const std::string &duration, bool withVolume, std::chrono::seconds freshFor, bool refresh,
+                                     std::string *note = nullptr)
+{
+    ChartRenderer renderer = getChartRenderer();
+    ImageOptions options = getImageOptions();
+    std::string request = "candlestick " + symbol + " " + periodKey(duration) + " " + (withVolume ? "y" : "n") + " " + renderVersion(renderer, options);
+    return cachedChart(
+        request, symbol, duration, [withVolume, renderer, options](const ChartData &data, std::string &note)
+        {
+            bool merged = false;
+            std::string image = renderCandleChart(data, withVolume, renderer, options, &merged);
+            note = merged ? "Note: this period has more days than fit in the chart, so every candle covers several days." : "";
+            return image;
+        },
+        freshFor, refresh, note);
+}
+
+std::string priceGraph(std::string symbol, std::string duration, int mode)
+{
+    return cachedPriceGraph(symbol, duration, mode, RENDER_CACHE_FRESH, false);
+}
+
+std::string createCandleChart(std::string symbol, std::string duration, bool withVolume, std::string *note)
+{
+    return cachedCandleChart(symbol, duration, withVolume, RENDER_CACHE_FRESH, false, note);
+}
+
+bool prerenderPriceGraph(const std::string &symbol, const std::string &duration, int mode, std::chrono::seconds freshFor)
+{
+    return !cachedPriceGraph(symbol, duration, mode, freshFor, true).empty();
+}
+
+bool prerenderCandleChart(const std::string &symbol, const std::string &duration, bool withVolume, std::chrono::seconds freshFor)
+{
+    return !cachedCandleChart(symbol, duration, withVolume, freshFor, true).empty();
 }
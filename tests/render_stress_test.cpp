@@ -0,0 +1,196 @@
+// Renders many charts at the same time, with the native and the Matplot++ (gnuplot) renderer, and checks that every
+// image is complete (PNG signature and IEND chunk, or an SVG document that is closed) and that no render received
+// the plot of another one. The charts are drawn from the recorded Yahoo Finance histories in bench/fixtures.
+// The Matplot++ test is skipped if gnuplot is not installed.
+// Usage: ./equity-test --gtest_filter="RenderStress*"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+#include "visualize.h"
+
+// Number of threads that render at the same time (more than the gnuplot pool has workers)
+static const size_t STRESS_THREADS = 16;
+
+// Files with the histories of the fixtures
+static const char *HISTORY_FIXTURES[] = {"history_AAPL.csv", "history_MSFT.csv", "history_NVDA.csv", "history_TSLA.csv",
+                                         "history_GSPC.csv", "history_GC_F.csv", "history_EURUSD_X.csv", "history_BTC-USD.csv"};
+
+// A chart to render
+struct RenderJob
+{
+    const ChartData *data;
+    bool candle;       // Candlestick chart instead of price graph
+    int mode;          // Mode of the price graph, or 1 to draw the volumes of the candlestick chart
+    ChartRenderer renderer;
+    ImageFormat format;
+    std::string image; // Result
+};
+
+// Reads a history fixture into chart data
+static ChartData loadFixture(const std::string &name)
+{
+    std::ifstream file(std::string(EQUITY_FIXTURES_DIR) + "/" + name);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    ChartData data;
+    data.currency = "USD";
+    for (const std::vector<std::string> &row : parseOHLCData(contents.str()))
+    {
+        data.dates.push_back(row[0]);
+        data.open.push_back(std::stod(row[1]));
+        data.high.push_back(std::stod(row[2]));
+        data.low.push_back(std::stod(row[3]));
+        data.close.push_back(std::stod(row[4]));
+        data.volume.push_back(row.size() >= 6 ? std::stod(row[5]) : 0);
+    }
+    return data;
+}
+
+// Returns the chart data of every fixture (loaded once)
+static const std::vector<ChartData> &fixtures()
+{
+    static const std::vector<ChartData> data = []()
+    {
+        std::vector<ChartData> all;
+        for (const char *name : HISTORY_FIXTURES)
+        {
+            all.push_back(loadFixture(name));
+        }
+        return all;
+    }();
+    return data;
+}
+
+// Adds a job for every fixture, chart and mode with the given renderer and format
+static void addJobs(std::vector<RenderJob> &jobs, ChartRenderer renderer, ImageFormat format)
+{
+    for (const ChartData &data : fixtures())
+    {
+        for (int mode = 1; mode <= 3; mode++)
+        {
+            jobs.push_back(RenderJob{&data, false, mode, renderer, format, ""});
+        }
+        for (int withVolume = 0; withVolume <= 1; withVolume++)
+        {
+            jobs.push_back(RenderJob{&data, true, withVolume, renderer, format, ""});
+        }
+    }
+}
+
+// Renders the jobs from STRESS_THREADS threads at the same time
+static void renderConcurrently(std::vector<RenderJob> &jobs)
+{
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < STRESS_THREADS; t++)
+    {
+        threads.emplace_back([&jobs, &next]()
+                             {
+                                 for (size_t i = next++; i < jobs.size(); i = next++)
+                                 {
+                                     RenderJob &job = jobs[i];
+                                     ImageOptions options;
+                                     options.format = job.format;
+                                     job.image = job.candle ? renderCandleChart(*job.data, job.mode == 1, job.renderer, options)
+                                                            : renderPriceGraph(*job.data, job.mode, job.renderer, options);
+                                 } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// Returns true if the image starts with the PNG signature and ends with the IEND chunk
+static bool isCompletePNG(const std::string &image)
+{
+    static const std::string signature("\x89PNG\r\n\x1a\n", 8);
+    static const std::string iend("\0\0\0\0IEND\xae\x42\x60\x82", 12);
+    return image.size() > signature.size() + iend.size() && image.compare(0, signature.size(), signature) == 0 &&
+           image.compare(image.size() - iend.size(), iend.size(), iend) == 0;
+}
+
+// Returns true if the image is an SVG document whose svg elements are all closed, with nothing after the last one
+static bool isCompleteSVG(const std::string &image)
+{
+    size_t opened = 0, closed = 0;
+    for (size_t pos = image.find("<svg"); pos != std::string::npos; pos = image.find("<svg", pos + 1))
+    {
+        opened++;
+    }
+    for (size_t pos = image.find("</svg>"); pos != std::string::npos; pos = image.find("</svg>", pos + 1))
+    {
+        closed++;
+    }
+    size_t end = image.find_last_not_of(" \t\r\n");
+    return opened > 0 && opened == closed && end != std::string::npos && end >= 5 && image.compare(0, 1, "<") == 0 &&
+           image.compare(end - 5, 6, "</svg>") == 0;
+}
+
+// Checks that every job delivered a complete image and that no two images are the same
+static void expectCompleteAndDistinct(const std::vector<RenderJob> &jobs)
+{
+    std::set<std::string> distinct;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        const RenderJob &job = jobs[i];
+        SCOPED_TRACE("job " + std::to_string(i) + (job.candle ? " (candlestick chart, " : " (price graph, ") +
+                     (job.renderer == ChartRenderer::Native ? "native, " : "matplot, ") + imageFileExtension(job.format) + ")");
+        ASSERT_FALSE(job.image.empty());
+        if (job.format == ImageFormat::SVG)
+        {
+            EXPECT_TRUE(isCompleteSVG(job.image));
+        }
+        else
+        {
+            EXPECT_TRUE(isCompletePNG(job.image));
+        }
+        distinct.insert(job.image);
+    }
+    EXPECT_EQ(distinct.size(), jobs.size());
+}
+
+// Returns true if gnuplot can be started
+static bool hasGnuplot()
+{
+    return std::system("gnuplot --version > /dev/null 2>&1") == 0;
+}
+
+TEST(RenderStressTest, NativeRenderer)
+{
+    std::vector<RenderJob> jobs;
+    addJobs(jobs, ChartRenderer::Native, ImageFormat::PalettePNG);
+    addJobs(jobs, ChartRenderer::Native, ImageFormat::PNG);
+    addJobs(jobs, ChartRenderer::Native, ImageFormat::SVG);
+
+    renderConcurrently(jobs);
+    expectCompleteAndDistinct(jobs);
+}
+
+TEST(RenderStressTest, NativeAndMatplotRenderers)
+{
+    if (!hasGnuplot())
+    {
+        GTEST_SKIP() << "gnuplot is not installed";
+    }
+
+    // Both renderers at the same time; the Matplot++ renders have to wait for the workers of the gnuplot pool
+    std::vector<RenderJob> jobs;
+    addJobs(jobs, ChartRenderer::Matplot, ImageFormat::PNG);
+    addJobs(jobs, ChartRenderer::Native, ImageFormat::PNG);
+    addJobs(jobs, ChartRenderer::Matplot, ImageFormat::SVG);
+    addJobs(jobs, ChartRenderer::Native, ImageFormat::SVG);
+
+    renderConcurrently(jobs);
+    expectCompleteAndDistinct(jobs);
+
+    GnuplotPoolStats stats = getGnuplotPoolStats();
+    EXPECT_EQ(stats.busy, 0u);
+    EXPECT_EQ(stats.failures, 0u);
+}
@@ -0,0 +1,77 @@
+// Checks that the response cache keeps complete replies only, so a reply built during an upstream outage
+// (prices that could not be fetched) is not served to every user for the lifetime of a cache entry.
+// Usage: ./equity-test --gtest_filter="ResponseCache*"
+
+#include <gtest/gtest.h>
+#include "data.h"
+#include "responsecache.h"
+
+TEST(ResponseCacheTest, KeepsCompleteReplies)
+{
+    ResponseCache cache;
+    int builds = 0;
+    cache.add("test", [&builds](bool &, bool &)
+              {
+                  builds++;
+                  return std::string("reply");
+              });
+
+    std::string reply;
+    EXPECT_TRUE(cache.get("test", reply));
+    EXPECT_EQ(reply, "reply");
+    EXPECT_TRUE(cache.get("test", reply));
+    EXPECT_EQ(reply, "reply");
+    EXPECT_EQ(builds, 1);
+    EXPECT_FALSE(cache.get("unknown", reply));
+}
+
+TEST(ResponseCacheTest, DoesNotKeepIncompleteReplies)
+{
+    ResponseCache cache;
+    int builds = 0;
+    cache.add("test", [&builds](bool &, bool &complete)
+              {
+                  builds++;
+                  complete = (builds > 2);
+                  return "reply " + std::to_string(builds);
+              });
+
+    // Every request gets the newest reply, until one is complete
+    std::string reply;
+    for (int i = 1; i <= 3; i++)
+    {
+        cache.get("test", reply);
+        EXPECT_EQ(reply, "reply " + std::to_string(i));
+    }
+    cache.get("test", reply);
+    EXPECT_EQ(reply, "reply 3");
+    EXPECT_EQ(builds, 3);
+}
+
+TEST(ResponseCacheTest, UpstreamOutage)
+{
+    // Nothing listens on the discard port, so every quote request fails
+    std::string upstream = upstreamUrl();
+    setUpstreamUrl("http://127.0.0.1:9");
+
+    ResponseCache cache;
+    int builds = 0;
+    size_t unavailable = 0;
+    cache.add("commodities", [&builds, &unavailable](bool &marketOpen, bool &complete)
+              {
+                  builds++;
+                  std::string reply = getFormattedPrices<Markdown, true>({"GC=F", "SI=F", "CL=F"}, {"Gold", "Silver", "Crude Oil"}, {},
+                                                                         &marketOpen, nullptr, &unavailable);
+                  complete = (unavailable == 0);
+                  return reply;
+              });
+
+    std::string reply;
+    cache.get("commodities", reply);
+    EXPECT_EQ(unavailable, 3u);
+    EXPECT_FALSE(reply.empty());
+    cache.get("commodities", reply);
+    EXPECT_EQ(builds, 2); // The failed reply was not cached
+
+    setUpstreamUrl(upstream);
+}
@@ -0,0 +1,96 @@
+// Checks the lookups of the symbol index: prefix lookup of symbols and names (autocompletion) and the fuzzy
+// name search (/search).
+// Usage: ./equity-test --gtest_filter="SymbolIndex*"
+
+#include <gtest/gtest.h>
+#include "symbolindex.h"
+
+// Fills an index with a few symbols of the catalog
+static void fill(SymbolIndex &index)
+{
+    index.add("AAPL", "Apple Inc.");
+    index.add("BAC", "Bank of America Corporation");
+    index.add("CL=F", "Crude Oil");
+    index.add("GC=F", "Gold");
+    index.add("VOW3.DE", "Volkswagen AG");
+    index.add("^FCHI", "CAC 40");
+    index.add("USDT-USD", "Tether USDt USD");
+    index.add("XRP-USD", "XRP USD");
+}
+
+TEST(SymbolIndexTest, LookupFindsSymbolsBeforeNames)
+{
+    SymbolIndex index;
+    fill(index);
+    index.add("BA", "Boeing Company");
+
+    std::vector<SymbolMatch> matches = index.lookup("ba");
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].symbol, "BA");
+    EXPECT_EQ(matches[1].symbol, "BAC");
+
+    matches = index.lookup("oil");
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].symbol, "CL=F");
+    EXPECT_EQ(matches[0].name, "Crude Oil");
+
+    EXPECT_TRUE(index.lookup("zzz").empty());
+}
+
+TEST(SymbolIndexTest, AddKeepsKnownSymbols)
+{
+    SymbolIndex index;
+    index.add("MSFT", "");
+    index.add("MSFT", "Microsoft Corporation");
+    index.add("MSFT", "Something else");
+
+    EXPECT_EQ(index.size(), 1u);
+    std::vector<SymbolMatch> matches = index.lookup("micro");
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].name, "Microsoft Corporation");
+}
+
+TEST(SymbolIndexTest, SearchToleratesTypos)
+{
+    SymbolIndex index;
+    fill(index);
+
+    std::vector<SearchResult> results = index.search("volkswagn");
+    ASSERT_FALSE(results.empty());
+    EXPECT_EQ(results[0].match.symbol, "VOW3.DE");
+    for (size_t i = 1; i < results.size(); i++)
+    {
+        EXPECT_LE(results[i].score, results[i - 1].score);
+    }
+
+    EXPECT_TRUE(index.search("qqqq").empty());
+}
+
+TEST(SymbolIndexTest, ResolveKeepsTickers)
+{
+    SymbolIndex index;
+    fill(index);
+
+    // Tickers that are not in the index must not be taken for a similar name (AT&T, Citigroup, Boeing and
+    // Barrick Gold would otherwise become USDT-USD, ^FCHI, BAC and GC=F)
+    for (const char *ticker : {"T", "C", "BA", "GOLD", "X", "O"})
+    {
+        EXPECT_EQ(index.resolve(ticker), ticker);
+    }
+
+    // Known symbols are returned as they are known, in whatever case they were typed
+    EXPECT_EQ(index.resolve("aapl"), "AAPL");
+    EXPECT_EQ(index.resolve("gc=f"), "GC=F");
+}
+
+TEST(SymbolIndexTest, ResolveNames)
+{
+    SymbolIndex index;
+    fill(index);
+
+    EXPECT_EQ(index.resolve("apple"), "AAPL");
+    EXPECT_EQ(index.resolve("Bank of America"), "BAC");
+    EXPECT_EQ(index.resolve("crude oil"), "CL=F");
+    EXPECT_EQ(index.resolve("volkswagn"), "VOW3.DE"); // Typo
+    EXPECT_EQ(index.resolve("microsoft"), "microsoft"); // Matches nothing
+}
@@ -0,0 +1,330 @@
+// Offline load generator: runs the slash command logic of the bot (CommandHandler) with synthetic interactions
+// from several threads, without connecting to Discord, and reports the throughput, the latency percentiles per
+// command and the memory high-water mark. Start equity-replay first so no request leaves the machine.
+// Usage: ./equity-loadgen [--upstream http://127.0.0.1:8480] [--data ../data] [--requests 2000 | --duration <s>]
+//                         [--concurrency 8] [--mix latestprice=30,metrics=20,...] [--symbols AAPL,MSFT,...]
+//                         [--periods 1mo,6mo,1y] [--seed 1]
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include "catalog.h"
+#include "commands.h"
+#include "telemetry.h"
+
+// Upstream of the load generator (the default address of equity-replay)
+constexpr const char *LOADGEN_UPSTREAM = "http://127.0.0.1:8480";
+
+// Default mix of commands (relative weights)
+static const char *DEFAULT_MIX = "latestprice=30,metrics=20,movements=10,pricegraph=10,candlestick=5,"
+                                 "majorindices=5,industries=5,commodities=5,currencies=3,crypto=2,search=5";
+
+// Default symbols and periods (the symbols of bench/fixtures)
+static const char *DEFAULT_SYMBOLS = "AAPL,MSFT,NVDA,TSLA,^GSPC,GC=F,EURUSD=X,BTC-USD";
+static const char *DEFAULT_PERIODS = "1w,1mo,3mo,6mo,1y";
+
+struct LoadOptions
+{
+    std::string upstream = LOADGEN_UPSTREAM;
+    std::string data = "../data";
+    size_t requests = 2000;
+    std::chrono::seconds duration{0}; // Run for this long instead of a number of requests
+    size_t concurrency = 8;
+    std::string mix = DEFAULT_MIX;
+    std::string symbols = DEFAULT_SYMBOLS;
+    std::string periods = DEFAULT_PERIODS;
+    unsigned seed = 1;
+};
+
+// Results of one command
+struct CommandStats
+{
+    LatencyHistogram latency;
+    std::atomic<uint64_t> failures{0};
+};
+
+static void printUsage()
+{
+    std::cout << "Usage: ./equity-loadgen [--upstream <url>] [--data <dir>] [--requests <n> | --duration <s>] [--concurrency <n>]\n"
+              << "                        [--mix <command=weight,...>] [--symbols <a,b,...>] [--periods <a,b,...>] [--seed <n>]\n"
+              << "  Default mix: " << DEFAULT_MIX << "\n";
+}
+
+// Splits a comma separated list
+static std::vector<std::string> split(const std::string &text)
+{
+    std::vector<std::string> parts;
+    std::istringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, ','))
+    {
+        if (!part.empty())
+        {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+// Returns the peak resident set size of the process in megabytes
+static double peakMemoryMB()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0); // Bytes
+#else
+    return usage.ru_maxrss / 1024.0; // Kilobytes
+#endif
+}
+
+// Creates synthetic interactions (command and options) like the ones users send
+class InteractionGenerator
+{
+public:
+    InteractionGenerator(const LoadOptions &options, const Catalog &catalog)
+        : symbols(split(options.symbols)), periods(split(options.periods))
+    {
+        for (const std::string &entry : split(options.mix))
+        {
+            size_t separator = entry.find('=');
+            commands.push_back(entry.substr(0, separator));
+            weights.push_back(separator == std::string::npos ? 1.0 : std::stod(entry.substr(separator + 1)));
+        }
+        for (const CatalogGroup &group : catalog.groups())
+        {
+            if (group.catalog == "indices")
+            {
+                regions.push_back(group.key);
+            }
+            else if (group.catalog == "industries")
+            {
+                industries.push_back(group.key);
+            }
+            names.insert(names.end(), group.names.begin(), group.names.end());
+        }
+    }
+
+    /// Returns the commands of the mix.
+    const std::vector<std::string> &mixCommands() const
+    {
+        return commands;
+    }
+
+    /// Creates an interaction.
+    void next(std::mt19937 &random, std::string &command, CommandOptions &options) const
+    {
+        command = commands[std::discrete_distribution<size_t>(weights.begin(), weights.end())(random)];
+        options.clear();
+        auto pick = [&random](const std::vector<std::string> &values) -> std::string
+        {
+            return values.empty() ? "" : values[std::uniform_int_distribution<size_t>(0, values.size() - 1)(random)];
+        };
+
+        options["symbol"] = pick(symbols);
+        options["period"] = pick(periods);
+        options["mode"] = std::to_string(std::uniform_int_distribution<int>(1, 3)(random));
+        options["volume"] = (random() % 2) ? "y" : "n";
+        options["description"] = (random() % 2) ? "y" : "n";
+        options["region"] = pick(regions);
+        options["industry"] = pick(industries);
+
+        // Searches for part of a name with a typo, like "volkswagn"
+        std::string name = pick(names);
+        if (name.size() > 4)
+        {
+            name.erase(std::uniform_int_distribution<size_t>(1, name.size() - 2)(random), 1);
+        }
+        options["name"] = name;
+    }
+
+private:
+    std::vector<std::string> commands;
+    std::vector<double> weights;
+    std::vector<std::string> symbols;
+    std::vector<std::string> periods;
+    std::vector<std::string> regions;
+    std::vector<std::string> industries;
+    std::vector<std::string> names;
+};
+
+// Returns true if a reply is an error message (or nothing at all)
+static bool isFailure(const CommandReply &reply)
+{
+    if (reply.content.empty() && reply.fileName.empty())
+    {
+        return true;
+    }
+    for (const char *prefix : {"Could not", "Oops", "Invalid", "Error"})
+    {
+        if (reply.content.rfind(prefix, 0) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Prints a row of the report
+static void printRow(const std::string &name, uint64_t count, uint64_t failures, double seconds, const LatencyHistogram &latency)
+{
+    std::cout << std::left << std::setw(14) << name << std::right << std::setw(8) << count << std::setw(9) << failures
+              << std::setw(10) << std::fixed << std::setprecision(1) << count / seconds
+              << std::setw(10) << std::setprecision(2) << latency.quantile(0.5) / 1000.0
+              << std::setw(10) << latency.quantile(0.9) / 1000.0 << std::setw(10) << latency.quantile(0.99) / 1000.0
+              << std::setw(10) << latency.quantile(1.0) / 1000.0 << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    LoadOptions options;
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                printUsage();
+                return 1;
+            }
+            if (arg == "--upstream")
+            {
+                options.upstream = argv[++i];
+            }
+            else if (arg == "--data")
+            {
+                options.data = argv[++i];
+            }
+            else if (arg == "--requests")
+            {
+                options.requests = std::stoul(argv[++i]);
+            }
+            else if (arg == "--duration")
+            {
+                options.duration = std::chrono::seconds(std::stol(argv[++i]));
+            }
+            else if (arg == "--concurrency")
+            {
+                options.concurrency = std::max<size_t>(1, std::stoul(argv[++i]));
+            }
+            else if (arg == "--mix")
+            {
+                options.mix = argv[++i];
+            }
+            else if (arg == "--symbols")
+            {
+                options.symbols = argv[++i];
+            }
+            else if (arg == "--periods")
+            {
+                options.periods = argv[++i];
+            }
+            else if (arg == "--seed")
+            {
+                options.seed = std::stoul(argv[++i]);
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        printUsage();
+        return 1;
+    }
+
+    setUpstreamUrl(options.upstream);
+    std::shared_ptr<const Catalog> catalog = Catalog::load(options.data);
+    CommandHandler handler([catalog]()
+                           { return catalog; });
+    InteractionGenerator generator(options, *catalog);
+    if (generator.mixCommands().empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::map<std::string, std::unique_ptr<CommandStats>> stats;
+    for (const std::string &command : generator.mixCommands())
+    {
+        stats.emplace(command, std::make_unique<CommandStats>());
+    }
+    CommandStats total;
+    double startMemory = peakMemoryMB();
+
+    std::cout << "Sending " << (options.duration.count() > 0 ? std::to_string(options.duration.count()) + " s of" : std::to_string(options.requests))
+              << " interactions from " << options.concurrency << " threads to " << options.upstream << std::endl;
+
+    // Closed loop: every thread sends its next interaction as soon as the previous one is answered
+    std::atomic<size_t> sent{0};
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + options.duration;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < options.concurrency; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+                                 std::mt19937 random(options.seed + static_cast<unsigned>(t));
+                                 std::string command;
+                                 CommandOptions commandOptions;
+                                 while (true)
+                                 {
+                                     if (options.duration.count() > 0 ? std::chrono::steady_clock::now() >= deadline
+                                                                      : sent.fetch_add(1) >= options.requests)
+                                     {
+                                         break;
+                                     }
+                                     generator.next(random, command, commandOptions);
+                                     auto begin = std::chrono::steady_clock::now();
+                                     CommandReply reply;
+                                     {
+                                         CommandScope scope(command);
+                                         reply = handler.execute(command, commandOptions);
+                                     }
+                                     auto elapsed = std::chrono::steady_clock::now() - begin;
+
+                                     CommandStats &commandStats = *stats.at(command);
+                                     commandStats.latency.record(elapsed);
+                                     total.latency.record(elapsed);
+                                     if (isFailure(reply))
+                                     {
+                                         commandStats.failures++;
+                                         total.failures++;
+                                     }
+                                 } });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n" << std::left << std::setw(14) << "command" << std::right << std::setw(8) << "count" << std::setw(9) << "failed"
+              << std::setw(10) << "req/s" << std::setw(10) << "p50 ms" << std::setw(10) << "p90 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "max ms" << "\n";
+    for (const auto &[command, commandStats] : stats)
+    {
+        if (commandStats->latency.count() > 0)
+        {
+            printRow(command, commandStats->latency.count(), commandStats->failures, seconds, commandStats->latency);
+        }
+    }
+    printRow("total", total.latency.count(), total.failures, seconds, total.latency);
+
+    std::cout << "\nDuration: " << std::setprecision(2) << seconds << " s\n"
+              << "Peak memory: " << std::setprecision(1) << peakMemoryMB() << " MB (" << startMemory << " MB before the load)\n";
+    return 0;
+}
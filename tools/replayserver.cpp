@@ -0,0 +1,422 @@
+// Local stand-in for the Yahoo Finance endpoints of the bot: replays recorded responses of v6/finance/options
+// (options_<symbol>.json) and v7/finance/download (history_<symbol>.csv) from a directory, with injectable latency,
+// errors and throttling, so load tests and benchmarks can run deterministically without the network.
+// In symbol file names '^' is left out and '=' becomes '_' (e.g. ^GSPC -> options_GSPC.json, GC=F -> options_GC_F.json).
+// With --record, responses that are missing are fetched from the real upstream once and stored in the directory.
+// Usage: ./equity-replay --fixtures ../bench/fixtures [--port 8480] [--latency <ms>] [--jitter <ms>]
+//                        [--error-rate <0..1>] [--rate-limit <requests/s>] [--record https://query1.finance.yahoo.com]
+// Then start the bot (or the load generator) with --upstream http://127.0.0.1:8480
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <curl/curl.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: SO_NOSIGPIPE is set on the socket instead
+#endif
+
+// Default port of the replay server
+constexpr uint16_t REPLAY_PORT = 8480;
+
+// How long an idle keep-alive connection stays open
+constexpr int IDLE_TIMEOUT_SECONDS = 5;
+
+// Responses of Yahoo Finance for unknown symbols
+static const char *OPTIONS_NOT_FOUND = "{\"optionChain\":{\"result\":[],\"error\":null}}";
+static const char *DOWNLOAD_NOT_FOUND = "404 Not Found: No data found, symbol may be delisted";
+
+struct ReplayOptions
+{
+    std::string fixtures;             // Directory with the recorded responses
+    std::string record;               // Upstream to record missing responses from (empty = replay only)
+    uint16_t port = REPLAY_PORT;
+    std::chrono::milliseconds latency{0}; // Added to every response
+    std::chrono::milliseconds jitter{0};  // Random extra latency (uniform between 0 and jitter)
+    double errorRate = 0;                 // Share of requests answered with 500
+    double rateLimit = 0;                 // Requests per second before 429 is returned (0 = unlimited)
+};
+
+struct Response
+{
+    int status = 200;
+    std::string contentType = "application/json";
+    std::string body;
+};
+
+static ReplayOptions options;
+static std::atomic<bool> stopping{false};
+static std::atomic<uint64_t> served{0}, missing{0}, recorded{0}, injectedErrors{0}, throttled{0};
+
+// Fixtures are read once and kept in memory, so the server never is the bottleneck
+static std::map<std::string, std::string> fixtureCache;
+static std::mutex fixtureMutex;
+
+// Token bucket of the rate limit
+static double tokens = 0;
+static std::chrono::steady_clock::time_point lastRefill = std::chrono::steady_clock::now();
+static std::mutex throttleMutex;
+
+static void printUsage()
+{
+    std::cout << "Usage: ./equity-replay --fixtures <dir> [--port <port>] [--latency <ms>] [--jitter <ms>]\n"
+              << "                       [--error-rate <0..1>] [--rate-limit <requests/s>] [--record <upstream url>]\n"
+              << "  Serves options_<symbol>.json and history_<symbol>.csv from <dir> at http://127.0.0.1:<port> (default " << REPLAY_PORT << ").\n";
+}
+
+// Decodes %XX sequences of a URL path
+static std::string urlDecode(const std::string &text)
+{
+    std::string result;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (text[i] == '%' && i + 2 < text.size())
+        {
+            result.push_back(static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16)));
+            i += 2;
+        }
+        else
+        {
+            result.push_back(text[i]);
+        }
+    }
+    return result;
+}
+
+// Returns the name of a symbol in fixture file names (e.g. "^GSPC" -> "GSPC", "GC=F" -> "GC_F")
+static std::string fixtureName(const std::string &symbol)
+{
+    std::string name;
+    for (char character : symbol)
+    {
+        if (character == '^')
+        {
+            continue;
+        }
+        name.push_back((character == '=' || character == '/') ? '_' : character);
+    }
+    return name;
+}
+
+// Looks up a fixture; false if the file does not exist
+static bool readFixture(const std::string &file, std::string &contents)
+{
+    std::lock_guard<std::mutex> lock(fixtureMutex);
+    auto it = fixtureCache.find(file);
+    if (it != fixtureCache.end())
+    {
+        contents = it->second;
+        return true;
+    }
+    std::ifstream stream(options.fixtures + "/" + file);
+    if (!stream.is_open())
+    {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << stream.rdbuf();
+    contents = fixtureCache.emplace(file, buffer.str()).first->second;
+    return true;
+}
+
+static size_t WriteCallback(char *ptr, size_t size, size_t nmemb, std::string *userdata)
+{
+    userdata->append(ptr, size * nmemb);
+    return size * nmemb;
+}
+
+// Fetches a response from the real upstream and stores it as fixture if it is valid
+static bool recordFixture(const std::string &target, const std::string &file, std::string &contents)
+{
+    CURL *curl = curl_easy_init();
+    if (!curl)
+    {
+        return false;
+    }
+    std::string url = options.record + target;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/122.0.0.0 Safari/537.36");
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &contents);
+    CURLcode result = curl_easy_perform(curl);
+    long status = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+    curl_easy_cleanup(curl);
+    if (result != CURLE_OK || status != 200 || contents.empty())
+    {
+        std::cerr << "Could not record " << url << " (status " << status << ")" << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(fixtureMutex);
+    std::ofstream stream(options.fixtures + "/" + file);
+    stream << contents;
+    fixtureCache[file] = contents;
+    recorded++;
+    std::cout << "Recorded " << file << std::endl;
+    return true;
+}
+
+// Takes a token of the rate limit; false if the request must be throttled
+static bool takeToken()
+{
+    if (options.rateLimit <= 0)
+    {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(throttleMutex);
+    auto now = std::chrono::steady_clock::now();
+    tokens = std::min(options.rateLimit, tokens + std::chrono::duration<double>(now - lastRefill).count() * options.rateLimit);
+    lastRefill = now;
+    if (tokens < 1)
+    {
+        return false;
+    }
+    tokens -= 1;
+    return true;
+}
+
+// Answers a request for the given target (path and query)
+static Response respond(const std::string &target)
+{
+    static thread_local std::mt19937 random(std::random_device{}());
+    Response response;
+
+    // Latency applies to every answer, including injected errors
+    std::chrono::milliseconds delay = options.latency;
+    if (options.jitter.count() > 0)
+    {
+        delay += std::chrono::milliseconds(std::uniform_int_distribution<long>(0, options.jitter.count())(random));
+    }
+    std::this_thread::sleep_for(delay);
+
+    if (!takeToken())
+    {
+        throttled++;
+        return Response{429, "text/plain", "Too Many Requests"};
+    }
+    if (options.errorRate > 0 && std::uniform_real_distribution<double>(0, 1)(random) < options.errorRate)
+    {
+        injectedErrors++;
+        return Response{500, "text/plain", "Internal Server Error"};
+    }
+
+    std::string path = target.substr(0, target.find('?'));
+    std::string file;
+    bool history = false;
+    if (path.rfind("/v6/finance/options/", 0) == 0)
+    {
+        file = "options_" + fixtureName(urlDecode(path.substr(std::strlen("/v6/finance/options/")))) + ".json";
+    }
+    else if (path.rfind("/v7/finance/download/", 0) == 0)
+    {
+        file = "history_" + fixtureName(urlDecode(path.substr(std::strlen("/v7/finance/download/")))) + ".csv";
+        history = true;
+        response.contentType = "text/csv";
+    }
+    else
+    {
+        return Response{404, "text/plain", "Not found"};
+    }
+
+    if (readFixture(file, response.body) || (!options.record.empty() && recordFixture(target, file, response.body)))
+    {
+        served++;
+        return response;
+    }
+
+    // Unknown symbols are answered the way Yahoo Finance does
+    missing++;
+    if (history)
+    {
+        return Response{404, "text/plain", DOWNLOAD_NOT_FOUND};
+    }
+    response.body = OPTIONS_NOT_FOUND;
+    return response;
+}
+
+static const char *statusText(int status)
+{
+    switch (status)
+    {
+    case 200:
+        return "OK";
+    case 404:
+        return "Not Found";
+    case 429:
+        return "Too Many Requests";
+    default:
+        return "Internal Server Error";
+    }
+}
+
+// Serves the requests of one (keep-alive) connection
+static void serveConnection(int client)
+{
+#ifdef SO_NOSIGPIPE
+    int noSignal = 1;
+    setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+    timeval timeout{IDLE_TIMEOUT_SECONDS, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string pending;
+    char buffer[4096];
+    while (!stopping)
+    {
+        // Read until the end of the headers (requests are GETs without body)
+        size_t end;
+        while ((end = pending.find("\r\n\r\n")) == std::string::npos)
+        {
+            ssize_t length = recv(client, buffer, sizeof(buffer), 0);
+            if (length <= 0)
+            {
+                close(client);
+                return;
+            }
+            pending.append(buffer, length);
+        }
+        std::string request = pending.substr(0, end);
+        pending.erase(0, end + 4);
+
+        // Request line: GET <target> HTTP/1.1
+        std::istringstream requestLine(request.substr(0, request.find("\r\n")));
+        std::string method, target, version;
+        requestLine >> method >> target >> version;
+        bool keepAlive = (version == "HTTP/1.1") && request.find("Connection: close") == std::string::npos;
+
+        Response response = (method == "GET") ? respond(target) : Response{404, "text/plain", "Not found"};
+        std::string reply = "HTTP/1.1 " + std::to_string(response.status) + " " + statusText(response.status) +
+                            "\r\nContent-Type: " + response.contentType + "\r\nContent-Length: " + std::to_string(response.body.size()) +
+                            (keepAlive ? "\r\n\r\n" : "\r\nConnection: close\r\n\r\n") + response.body;
+        for (size_t sent = 0; sent < reply.size();)
+        {
+            ssize_t written = send(client, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0)
+            {
+                close(client);
+                return;
+            }
+            sent += written;
+        }
+        if (!keepAlive)
+        {
+            break;
+        }
+    }
+    close(client);
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                printUsage();
+                return 1;
+            }
+            if (arg == "--fixtures")
+            {
+                options.fixtures = argv[++i];
+            }
+            else if (arg == "--port")
+            {
+                options.port = static_cast<uint16_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--latency")
+            {
+                options.latency = std::chrono::milliseconds(std::stol(argv[++i]));
+            }
+            else if (arg == "--jitter")
+            {
+                options.jitter = std::chrono::milliseconds(std::stol(argv[++i]));
+            }
+            else if (arg == "--error-rate")
+            {
+                options.errorRate = std::stod(argv[++i]);
+            }
+            else if (arg == "--rate-limit")
+            {
+                options.rateLimit = std::stod(argv[++i]);
+            }
+            else if (arg == "--record")
+            {
+                options.record = argv[++i];
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        printUsage();
+        return 1;
+    }
+    if (options.fixtures.empty())
+    {
+        printUsage();
+        return 1;
+    }
+    tokens = options.rateLimit;
+
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (server < 0 || bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(server, 128) < 0)
+    {
+        std::cerr << "Could not listen on port " << options.port << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    std::signal(SIGINT, [](int) { stopping = true; });
+    std::signal(SIGTERM, [](int) { stopping = true; });
+    std::cout << "Replaying " << options.fixtures << " at http://127.0.0.1:" << options.port << std::endl;
+
+    while (!stopping)
+    {
+        pollfd request{server, POLLIN, 0};
+        if (poll(&request, 1, 500) <= 0)
+        {
+            continue;
+        }
+        int client = accept(server, nullptr, nullptr);
+        if (client >= 0)
+        {
+            std::thread(serveConnection, client).detach();
+        }
+    }
+
+    close(server);
+    curl_global_cleanup();
+    std::cout << "Served " << served << " responses (" << recorded << " recorded), " << missing << " unknown symbols, "
+              << injectedErrors << " injected errors, " << throttled << " throttled requests" << std::endl;
+    return 0;
+}